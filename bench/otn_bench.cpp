@@ -0,0 +1,487 @@
+#include <benchmark/benchmark.h>
+
+#include "workload.hpp"
+
+#include "otn/admission_policy.hpp"
+#include "otn/candidate.hpp"
+#include "otn/container_tree.hpp"
+#include "otn/fragmentation.hpp"
+#include "otn/free_extent_index.hpp"
+#include "otn/grooming_planner.hpp"
+#include "otn/monte_carlo.hpp"
+#include "otn/odu_snapshot.hpp"
+#include "otn/odu_store.hpp"
+#include "otn/simulation.hpp"
+#include "otn/trace.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+/*
+ *  - Hot-path benchmarks for grooming, fragmentation and admission
+ *  - Arguments: parent ODU level (2..4), occupancy percent, candidate count
+ *  - JSON: otn_bench --benchmark_out=out.json --benchmark_out_format=json
+ *    (or build the bench_json target)
+ */
+
+using namespace otn;
+using otn::bench::make_workload;
+using otn::bench::level_from_arg;
+
+namespace {
+
+void level_occupancy_args(benchmark::internal::Benchmark* b) {
+    for (std::int64_t level : {2, 3, 4}) {
+        for (std::int64_t pct : {25, 50, 75, 95}) {
+            b->Args({level, pct});
+        }
+    }
+}
+
+void admission_args(benchmark::internal::Benchmark* b) {
+    for (std::int64_t level : {3, 4}) {
+        for (std::int64_t pct : {25, 75}) {
+            for (std::int64_t candidates : {16, 256, 4096}) {
+                b->Args({level, pct, candidates});
+            }
+        }
+    }
+}
+
+// ODU1 leaves groomed four to an ODU2: 500k nodes for the default size
+OduStore make_baseline(std::size_t odu2_count = 100000) {
+    OduStore store;
+    store.reserve(odu2_count * 5, odu2_count * 4);
+
+    std::vector<ChildPlacement> leaves(4);
+    for (std::size_t p = 0; p < odu2_count; ++p) {
+        for (std::size_t i = 0; i < 4; ++i) {
+            leaves[i] = {store.add_leaf(OduLevel::ODU1, 1000 + i), i};
+        }
+        store.add_aggregate(OduLevel::ODU2, leaves);
+    }
+    return store;
+}
+
+const std::string& baseline_snapshot() {
+    static const std::string path = [] {
+        const auto p = std::filesystem::temp_directory_path() / "otn_bench_baseline.bin";
+        make_baseline().save(p.string());
+        return p.string();
+    }();
+    return path;
+}
+
+// Churn trace of 1M events: ODU1/ODU2 adds with Poisson timing, removes of random live demands
+std::vector<TraceRecord> make_trace(std::size_t events = 1000000) {
+    std::mt19937_64 rng(7);
+    std::exponential_distribution<double> gap(1000.0);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+    std::vector<TraceRecord> trace;
+    std::vector<uint64_t> live;
+    trace.reserve(events);
+
+    double t = 0.0;
+    uint64_t next_id = 0;
+    while (trace.size() < events) {
+        t += gap(rng);
+        TraceRecord r;
+        r.timestamp = t;
+        if (!live.empty() && coin(rng) < 0.5) {
+            const std::size_t k = static_cast<std::size_t>(rng() % live.size());
+            r.op = TraceOp::REMOVE;
+            r.demand_id = live[k];
+            live[k] = live.back();
+            live.pop_back();
+        } else {
+            r.demand_id = next_id++;
+            r.level = coin(rng) < 0.8 ? OduLevel::ODU1 : OduLevel::ODU2;
+            r.payload_bytes = 1000;
+            r.preferred_parent = static_cast<uint32_t>(rng() % 16);
+            live.push_back(r.demand_id);
+        }
+        trace.push_back(r);
+    }
+    return trace;
+}
+
+const std::string& trace_file(TraceFormat format) {
+    static const std::vector<TraceRecord> trace = make_trace();
+    static const std::string csv = [] {
+        const auto p = std::filesystem::temp_directory_path() / "otn_bench_trace.csv";
+        std::ofstream out(p);
+        out.precision(17);
+        for (const TraceRecord& r : trace) {
+            out << r.timestamp << (r.op == TraceOp::ADD ? ",add," : ",remove,") << r.demand_id;
+            if (r.op == TraceOp::ADD) {
+                out << ",ODU" << int(r.level) << "," << r.payload_bytes << "," << r.preferred_parent;
+            }
+            out << "\n";
+        }
+        return p.string();
+    }();
+    static const std::string binary = [] {
+        const auto p = std::filesystem::temp_directory_path() / "otn_bench_trace.bin";
+        BinaryTraceWriter writer(p.string());
+        for (const TraceRecord& r : trace) writer.write(r);
+        writer.close();
+        return p.string();
+    }();
+    return format == TraceFormat::CSV ? csv : binary;
+}
+
+} // anonymous namespace
+
+// ---------------- GROOMING ----------------
+
+static void BM_PlanGrooming(benchmark::State& state) {
+    const OduLevel parent = level_from_arg(state.range(0));
+    const OduLevel child =
+        static_cast<OduLevel>(static_cast<std::uint8_t>(parent) - 1);
+
+    // Fill the parent completely with adjacent-level children
+    std::vector<Odu> children(
+        tributary_slots(parent) / tributary_slots(child),
+        Odu(child, 100)
+    );
+
+    for (auto _ : state) {
+        auto grooming = plan_grooming(parent, children);
+        benchmark::DoNotOptimize(grooming.data());
+    }
+    state.SetItemsProcessed(state.iterations() * children.size());
+}
+BENCHMARK(BM_PlanGrooming)->DenseRange(2, 4);
+
+static void BM_OccupiedSlots(benchmark::State& state) {
+    const auto w = make_workload(level_from_arg(state.range(0)), state.range(1), 0);
+
+    for (auto _ : state) {
+        auto slots = occupied_slots(w.parent_level, w.grooming);
+        benchmark::DoNotOptimize(slots);
+    }
+}
+BENCHMARK(BM_OccupiedSlots)->Apply(level_occupancy_args);
+
+static void BM_FeasibleOffsets(benchmark::State& state) {
+    const auto w = make_workload(level_from_arg(state.range(0)), state.range(1), 2);
+    const Odu& candidate = *w.candidates.front().child;
+
+    for (auto _ : state) {
+        auto offsets = feasible_offsets(w.parent_level, w.grooming, candidate);
+        benchmark::DoNotOptimize(offsets.data());
+    }
+}
+BENCHMARK(BM_FeasibleOffsets)->Apply(level_occupancy_args);
+
+// One table per grooming state, reused for every candidate
+static void BM_FeasibleOffsetsTable(benchmark::State& state) {
+    const auto w = make_workload(level_from_arg(state.range(0)), state.range(1), 2);
+    const Odu& candidate = *w.candidates.front().child;
+    const FeasibilityTable table(w.parent_level, w.grooming);
+
+    for (auto _ : state) {
+        auto offsets = feasible_offsets(table, candidate);
+        benchmark::DoNotOptimize(offsets.data());
+    }
+}
+BENCHMARK(BM_FeasibleOffsetsTable)->Apply(level_occupancy_args);
+
+static void BM_BuildFeasibilityTable(benchmark::State& state) {
+    const auto w = make_workload(level_from_arg(state.range(0)), state.range(1), 0);
+
+    for (auto _ : state) {
+        FeasibilityTable table(w.parent_level, w.grooming);
+        benchmark::DoNotOptimize(table.mask(OduLevel::ODU1).words());
+    }
+}
+BENCHMARK(BM_BuildFeasibilityTable)->Apply(level_occupancy_args);
+
+// ---------------- FRAGMENTATION ----------------
+
+static void BM_AnalyzeFragmentation(benchmark::State& state) {
+    const auto w = make_workload(level_from_arg(state.range(0)), state.range(1), 0);
+
+    for (auto _ : state) {
+        auto metrics = analyze_fragmentation(w.grooming);
+        benchmark::DoNotOptimize(metrics);
+    }
+    state.counters["children"] = static_cast<double>(w.grooming.size());
+}
+BENCHMARK(BM_AnalyzeFragmentation)->Apply(level_occupancy_args);
+
+static void BM_FragmentationCost(benchmark::State& state) {
+    const auto w = make_workload(level_from_arg(state.range(0)), state.range(1), 0);
+    const FragmentationMetrics metrics = analyze_fragmentation(w.grooming);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fragmentation_cost(metrics));
+    }
+}
+BENCHMARK(BM_FragmentationCost)->Apply(level_occupancy_args);
+
+static void BM_RepackSizeAware(benchmark::State& state) {
+    const auto w = make_workload(level_from_arg(state.range(0)), state.range(1), 0);
+
+    for (auto _ : state) {
+        auto repacked = repack_grooming_size_aware(w.parent_level, w.grooming);
+        benchmark::DoNotOptimize(repacked.data());
+    }
+}
+BENCHMARK(BM_RepackSizeAware)->Apply(level_occupancy_args);
+
+static void BM_RepackDeterministic(benchmark::State& state) {
+    const auto w = make_workload(level_from_arg(state.range(0)), state.range(1), 0);
+
+    for (auto _ : state) {
+        auto repacked = repack_grooming_deterministic(w.parent_level, w.grooming);
+        benchmark::DoNotOptimize(repacked.data());
+    }
+}
+BENCHMARK(BM_RepackDeterministic)->Apply(level_occupancy_args);
+
+// ---------------- ADMISSION ----------------
+
+static void BM_AdmitCandidates(benchmark::State& state) {
+    const auto w = make_workload(
+        level_from_arg(state.range(0)), state.range(1), state.range(2)
+    );
+
+    for (auto _ : state) {
+        auto result = admit_candidates(w.parent_level, w.grooming, w.candidates);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * w.candidates.size());
+}
+BENCHMARK(BM_AdmitCandidates)->Apply(admission_args);
+
+// Arg 0: CostPolicyKind, arg 1: 0 = compile-time dispatch, 1 = CostPolicy
+static void BM_BestPlacementPolicy(benchmark::State& state) {
+    const auto kind = static_cast<CostPolicyKind>(state.range(0));
+    const Odu leaf(OduLevel::ODU1, {});
+
+    // Every other ODU1 slot of an ODU4 occupied: 40 feasible offsets
+    std::vector<GroomedChild> grooming;
+    for (std::size_t offset = 0; offset < 80; offset += 2) grooming.emplace_back(&leaf, offset);
+    const AdmissionEngine engine(OduLevel::ODU4, grooming);
+
+    if (state.range(1) == 0) {
+        for (auto _ : state) {
+            const AdmissionResult r = dispatch_cost_policy(kind, {}, [&](const auto& policy) {
+                return engine.best_placement(leaf, policy);
+            });
+            benchmark::DoNotOptimize(r.chosen_offset);
+        }
+    } else {
+        const CostPolicy policy = make_cost_policy(kind);
+        for (auto _ : state) {
+            const AdmissionResult r = engine.best_placement(leaf, policy);
+            benchmark::DoNotOptimize(r.chosen_offset);
+        }
+    }
+}
+BENCHMARK(BM_BestPlacementPolicy)->ArgsProduct({benchmark::CreateDenseRange(0, static_cast<int>(kCostPolicyKindCount) - 1, 1), {0, 1}});
+
+// Arg 0: capacity, arg 1: 0 = FreeExtentIndex best fit, 1 = SlotMap run scan
+// (the bitmap is capped at SlotMap::kMaxSlots); width-4 churn held near half full
+static void BM_FreeExtentBestFit(benchmark::State& state) {
+    const auto capacity = static_cast<std::size_t>(state.range(0));
+    constexpr std::size_t kWidth = 4;
+
+    std::mt19937_64 rng(7);
+    FreeExtentIndex index(capacity);
+    SlotMap occupancy(state.range(1) == 1 ? capacity : 0);
+    std::vector<std::size_t> held;
+
+    // Random singles fragment the space before the width-4 churn starts
+    for (std::size_t i = 0; i < capacity / 4; ++i) {
+        const std::size_t slot = rng() % capacity;
+        if (!index.range_free(slot, 1)) continue;
+        index.allocate(slot, 1);
+        if (state.range(1) == 1) occupancy.set_range(slot, 1);
+    }
+
+    // Smallest run holding kWidth by scanning the bitmap run by run
+    const auto scan_best_fit = [&] {
+        std::size_t best = SlotMap::npos;
+        std::size_t best_len = SlotMap::npos;
+        std::size_t start = occupancy.find_first_fit(1);
+        while (start != SlotMap::npos) {
+            const std::size_t next = occupancy.find_next_set(start);
+            const std::size_t end = next == SlotMap::npos ? capacity : next;
+            if (end - start >= kWidth && end - start < best_len) {
+                best = start;
+                best_len = end - start;
+            }
+            start = end < capacity ? occupancy.find_first_fit(1, end) : SlotMap::npos;
+        }
+        return best;
+    };
+
+    for (auto _ : state) {
+        const std::size_t offset = state.range(1) == 0 ? index.best_fit(kWidth) : scan_best_fit();
+        if (offset != FreeExtentIndex::npos && held.size() * kWidth < capacity / 2) {
+            index.allocate(offset, kWidth);
+            if (state.range(1) == 1) occupancy.set_range(offset, kWidth);
+            held.push_back(offset);
+        } else if (!held.empty()) {
+            const std::size_t i = rng() % held.size();
+            index.release(held[i], kWidth);
+            if (state.range(1) == 1) occupancy.clear_range(held[i], kWidth);
+            held[i] = held.back();
+            held.pop_back();
+        }
+    }
+    state.counters["extents"] = static_cast<double>(index.extent_count());
+}
+BENCHMARK(BM_FreeExtentBestFit)
+    ->Args({80, 0})->Args({80, 1})
+    ->Args({static_cast<int64_t>(SlotMap::kMaxSlots), 0})
+    ->Args({static_cast<int64_t>(SlotMap::kMaxSlots), 1})
+    ->Args({1 << 16, 0});
+
+// Arg: root ODU4 count; mixed ODU1/ODU2/ODU3 churn held near full
+static void BM_ContainerTreeChurn(benchmark::State& state) {
+    ContainerTree tree;
+    for (int64_t i = 0; i < state.range(0); ++i) tree.add_root(OduLevel::ODU4);
+
+    std::mt19937_64 rng(3);
+    std::vector<DemandId> active;
+    const auto next_level = [&] {
+        const uint64_t r = rng() % 10;
+        return r < 7 ? OduLevel::ODU1 : (r < 9 ? OduLevel::ODU2 : OduLevel::ODU3);
+    };
+
+    // Warm up to blocking so the search runs against a full tree
+    for (int64_t i = 0; i < state.range(0) * 200; ++i) {
+        const HierarchicalPlacement p = tree.place(next_level());
+        if (p.admitted) active.push_back(p.demand);
+    }
+
+    uint64_t visited = 0;
+    for (auto _ : state) {
+        const std::size_t i = rng() % active.size();
+        tree.release(active[i]);
+        active[i] = active.back();
+        active.pop_back();
+
+        const HierarchicalPlacement p = tree.place(next_level());
+        if (p.admitted) active.push_back(p.demand);
+        visited += p.visited;
+    }
+    state.counters["visited"] = benchmark::Counter(
+        static_cast<double>(visited), benchmark::Counter::kAvgIterations
+    );
+    state.counters["containers"] = static_cast<double>(tree.container_count());
+}
+BENCHMARK(BM_ContainerTreeChurn)->Arg(1)->Arg(16)->Arg(256);
+
+// ---------------- SNAPSHOT ----------------
+
+static void BM_BaselineRebuild(benchmark::State& state) {
+    for (auto _ : state) {
+        OduStore store = make_baseline();
+        benchmark::DoNotOptimize(store.size());
+    }
+}
+BENCHMARK(BM_BaselineRebuild)->Unit(benchmark::kMillisecond);
+
+static void BM_SnapshotMap(benchmark::State& state) {
+    const std::string& path = baseline_snapshot();
+    for (auto _ : state) {
+        MappedSnapshot snap(path);
+        benchmark::DoNotOptimize(snap.payload_size(OduHandle{0}));
+    }
+}
+BENCHMARK(BM_SnapshotMap)->Unit(benchmark::kMicrosecond);
+
+static void BM_SnapshotLoad(benchmark::State& state) {
+    const std::string& path = baseline_snapshot();
+    for (auto _ : state) {
+        OduStore store = OduStore::load(path);
+        benchmark::DoNotOptimize(store.size());
+    }
+}
+BENCHMARK(BM_SnapshotLoad)->Unit(benchmark::kMillisecond);
+
+static void BM_SnapshotVerify(benchmark::State& state) {
+    const MappedSnapshot snap(baseline_snapshot());
+    for (auto _ : state) {
+        snap.verify();
+    }
+}
+BENCHMARK(BM_SnapshotVerify)->Unit(benchmark::kMillisecond);
+
+// ---------------- TRACE REPLAY ----------------
+
+// Arg: 0 = CSV, 1 = binary
+static void BM_TraceRead(benchmark::State& state) {
+    const std::string& path = trace_file(state.range(0) ? TraceFormat::BINARY : TraceFormat::CSV);
+
+    uint64_t records = 0, bytes = 0;
+    for (auto _ : state) {
+        TraceReader reader(path);
+        std::vector<TraceRecord> chunk;
+        while (reader.next_chunk(chunk)) records += chunk.size();
+        bytes += reader.file_bytes();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(records));
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_TraceRead)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_TraceReplay(benchmark::State& state) {
+    const std::string& path = trace_file(state.range(0) ? TraceFormat::BINARY : TraceFormat::CSV);
+
+    ReplayConfig config;
+    config.parent_count = 16;
+    config.policy = SimAdmissionPolicy::FIRST_FIT;
+
+    uint64_t records = 0;
+    for (auto _ : state) {
+        TraceReader reader(path);
+        records += replay_trace(reader, config).records;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(records));
+}
+BENCHMARK(BM_TraceReplay)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// ---------------- SIMULATION ----------------
+
+static void BM_Simulation(benchmark::State& state) {
+    SimulationConfig config;
+    config.parent_level = OduLevel::ODU4;
+    config.parent_count = 16;
+    config.demand_mix = {{OduLevel::ODU1, 0.8}, {OduLevel::ODU2, 0.2}};
+    config.policy = static_cast<SimAdmissionPolicy>(state.range(0));
+    config.arrival_rate = 1000.0;
+    config.arrivals = 100000;
+
+    uint64_t events = 0;
+    for (auto _ : state) {
+        events += Simulator(config).run().events;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(events));
+}
+BENCHMARK(BM_Simulation)->DenseRange(0, static_cast<int>(kCostPolicyKindCount) - 1)->Unit(benchmark::kMillisecond);
+
+static void BM_MonteCarlo(benchmark::State& state) {
+    MonteCarloConfig config;
+    config.base.parent_count = 4;
+    config.base.demand_mix = {{OduLevel::ODU1, 0.8}, {OduLevel::ODU2, 0.2}};
+    config.base.arrivals = 20000;
+    config.loads = {100.0, 200.0, 300.0};
+    config.replications = 16;
+    config.threads = static_cast<std::size_t>(state.range(0));
+
+    uint64_t events = 0;
+    for (auto _ : state) {
+        events += run_monte_carlo(config).total_events;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(events));
+}
+BENCHMARK(BM_MonteCarlo)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
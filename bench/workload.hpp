@@ -0,0 +1,100 @@
+#pragma once
+
+#include "otn/grooming_planner.hpp"
+#include "otn/odu.hpp"
+#include "otn/slot_map.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace otn::bench {
+
+/*
+ *  - Seeded random grooming workloads for the benchmarks
+ *  - Leaves live in a deque so GroomedChild / Candidate pointers stay valid
+ *  - Same seed + arguments always give the same workload
+ */
+struct Workload {
+    OduLevel parent_level;
+    std::deque<Odu> leaves;
+    std::vector<GroomedChild> grooming;
+    std::vector<Candidate> candidates;
+};
+
+inline OduLevel level_from_arg(std::int64_t arg) {
+    return static_cast<OduLevel>(static_cast<std::uint8_t>(arg));
+}
+
+// Child levels that fit at least once into the parent
+inline std::vector<OduLevel> child_levels(OduLevel parent) {
+    std::vector<OduLevel> levels;
+    for (std::uint8_t l = 1; l < static_cast<std::uint8_t>(parent); ++l) {
+        levels.push_back(static_cast<OduLevel>(l));
+    }
+    if (levels.empty()) levels.push_back(OduLevel::ODU1);
+    return levels;
+}
+
+/*
+ *  - Fills parent to roughly occupancy_pct percent with random children at
+ *    random feasible offsets (narrow children are favoured so high ratios
+ *    are reachable)
+ *  - Adds candidate_count candidates spread over fresh leaves, two offsets
+ *    per leaf, drawn from anywhere in the parent's slot range
+ */
+inline Workload make_workload(
+    OduLevel parent_level,
+    std::size_t occupancy_pct,
+    std::size_t candidate_count,
+    std::uint64_t seed = 42
+) {
+    std::mt19937_64 rng(seed);
+
+    Workload w{parent_level, {}, {}, {}};
+
+    const std::size_t capacity = tributary_slots(parent_level);
+    const std::size_t target = capacity * occupancy_pct / 100;
+    const auto levels = child_levels(parent_level);
+
+    SlotMap occupancy(capacity);
+    std::size_t misses = 0;
+
+    while (occupancy.count() < target && misses < 64) {
+        // Bias towards the narrowest level: 3 in 4 draws
+        std::uniform_int_distribution<std::size_t> pick(0, levels.size() * 4 - 1);
+        const std::size_t draw = pick(rng);
+        const OduLevel level = draw < levels.size() * 3 ? levels.front()
+                                                        : levels[draw % levels.size()];
+
+        const std::size_t width = tributary_slots(level);
+        const auto offsets = occupancy.fit_mask(width).to_offsets();
+        if (offsets.empty() || occupancy.count() + width > target) {
+            ++misses;
+            continue;
+        }
+
+        std::uniform_int_distribution<std::size_t> at(0, offsets.size() - 1);
+        const std::size_t offset = offsets[at(rng)];
+
+        w.leaves.emplace_back(level, 100);
+        w.grooming.emplace_back(&w.leaves.back(), offset);
+        occupancy.set_range(offset, width);
+    }
+
+    std::uniform_int_distribution<std::size_t> any_offset(0, capacity - 1);
+    for (std::size_t i = 0; i < candidate_count; i += 2) {
+        w.leaves.emplace_back(levels.front(), 100);
+        const Odu* child = &w.leaves.back();
+
+        w.candidates.push_back({child, any_offset(rng), 0.0});
+        if (i + 1 < candidate_count) {
+            w.candidates.push_back({child, any_offset(rng), 0.0});
+        }
+    }
+
+    return w;
+}
+
+} // namespace otn::bench
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "otn/fragmentation.hpp"
+#include "otn/free_extent_index.hpp"
+#include "otn/slot_map.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace otn {
+
+/*
+ *  - What a cost policy may look at when scoring a placement: the parent's
+ *    live occupancy, its incremental fragmentation state and its free runs
+ *  - The placement [offset, offset + width) is always feasible
+ *  - extents is empty unless the AdmissionEngine was built to index them;
+ *    only policies that declare pick() (below) read it
+ */
+struct PlacementView {
+    const SlotMap& occupancy;
+    const FragmentationState& fragmentation;
+    const FreeExtentIndex& extents;
+};
+
+/*
+ *  - Cost policy: any type with
+ *      double score(const PlacementView& view, std::size_t offset, std::size_t width) const;
+ *    lower is better, equal scores resolve to the lowest offset
+ *  - Passed as a template parameter to AdmissionEngine::evaluate /
+ *    best_placement and admit_candidates, so the scoring call inlines
+ *  - A policy whose score never decreases with the offset may declare
+ *      static constexpr bool kFirstFeasibleWins = true;
+ *    best_placement then returns the first feasible offset without scoring
+ *  - A policy that can name its winner from the free runs may declare
+ *      std::size_t pick(const PlacementView& view, std::size_t width) const;
+ *    (the offset best_placement's scan would choose, or npos); best_placement
+ *    then makes one O(log n) index query instead of scanning
+ */
+
+// Weighted fragmentation_cost of the layout after the placement (the default)
+class MinFragmentationPolicy {
+public:
+    MinFragmentationPolicy() = default;
+    explicit MinFragmentationPolicy(const FragmentationCostWeights& weights) : weights_(weights) {}
+
+    const FragmentationCostWeights& weights() const { return weights_; }
+
+    double score(const PlacementView& view, std::size_t offset, std::size_t width) const {
+        return fragmentation_cost(view.fragmentation.what_if(offset, width), weights_);
+    }
+
+private:
+    FragmentationCostWeights weights_{};
+};
+
+// Lowest feasible offset
+struct FirstFitPolicy {
+    static constexpr bool kFirstFeasibleWins = true;
+
+    double score(const PlacementView&, std::size_t offset, std::size_t) const {
+        return static_cast<double>(offset);
+    }
+};
+
+// Highest feasible offset
+struct LastFitPolicy {
+    double score(const PlacementView&, std::size_t offset, std::size_t) const {
+        return -static_cast<double>(offset);
+    }
+};
+
+// Length of the free run containing [offset, offset + width)
+inline std::size_t free_run_length(const SlotMap& occupancy, std::size_t offset, std::size_t width) {
+    const std::size_t prev = occupancy.find_prev_set(offset);
+    const std::size_t next = occupancy.find_next_set(offset + width);
+
+    const std::size_t start = prev == SlotMap::npos ? 0 : prev + 1;
+    const std::size_t end = next == SlotMap::npos ? occupancy.capacity() : next;
+    return end - start;
+}
+
+// Smallest free run that holds the child (fewest slots left over)
+struct BestFitPolicy {
+    double score(const PlacementView& view, std::size_t offset, std::size_t width) const {
+        return static_cast<double>(free_run_length(view.occupancy, offset, width) - width);
+    }
+
+    std::size_t pick(const PlacementView& view, std::size_t width) const {
+        return view.extents.best_fit(width);
+    }
+};
+
+// A free run exactly as wide as the child if there is one, else first fit
+struct ExactFitPolicy {
+    double score(const PlacementView& view, std::size_t offset, std::size_t width) const {
+        return free_run_length(view.occupancy, offset, width) == width ? 0.0 : 1.0;
+    }
+
+    std::size_t pick(const PlacementView& view, std::size_t width) const {
+        const std::size_t best = view.extents.best_fit(width);
+        if (best != FreeExtentIndex::npos && view.extents.extent_at(best).length == width) {
+            return best;
+        }
+        return view.extents.first_fit(width);
+    }
+};
+
+// Largest free run, leaving the most room next to the child
+struct WorstFitPolicy {
+    double score(const PlacementView& view, std::size_t offset, std::size_t width) const {
+        return -static_cast<double>(free_run_length(view.occupancy, offset, width));
+    }
+
+    std::size_t pick(const PlacementView& view, std::size_t width) const {
+        return view.extents.worst_fit(width);
+    }
+};
+
+// Smallest largest interior gap after the placement
+struct MinMaxGapPolicy {
+    double score(const PlacementView& view, std::size_t offset, std::size_t width) const {
+        return static_cast<double>(view.fragmentation.what_if(offset, width).max_gap);
+    }
+};
+
+namespace detail {
+
+template <typename Policy, typename = void>
+struct first_feasible_wins : std::false_type {};
+
+template <typename Policy>
+struct first_feasible_wins<Policy, std::void_t<decltype(Policy::kFirstFeasibleWins)>>
+    : std::integral_constant<bool, Policy::kFirstFeasibleWins> {};
+
+template <typename Policy, typename = void>
+struct has_pick : std::false_type {};
+
+template <typename Policy>
+struct has_pick<Policy, std::void_t<decltype(std::declval<const Policy&>().pick(
+    std::declval<const PlacementView&>(), std::size_t{}))>> : std::true_type {};
+
+} // namespace detail
+
+// ---------------- RUNTIME SELECTION ----------------
+
+/*
+ *  - Type-erased cost policy for configuration-driven selection
+ *  - Wraps any policy by value; copies share the wrapped policy
+ *  - Itself a policy, at the price of one virtual call per scored offset;
+ *    prefer dispatch_cost_policy where the hot loop matters
+ *  - Default-constructed it is MinFragmentationPolicy with default weights
+ */
+class CostPolicy {
+public:
+    CostPolicy() : CostPolicy(MinFragmentationPolicy{}) {}
+
+    template <typename Policy, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Policy>, CostPolicy>>>
+    CostPolicy(Policy policy)
+        : impl_(std::make_shared<const Model<Policy>>(std::move(policy))) {}
+
+    double score(const PlacementView& view, std::size_t offset, std::size_t width) const {
+        return impl_->score(view, offset, width);
+    }
+
+private:
+    struct Concept {
+        virtual ~Concept() = default;
+        virtual double score(const PlacementView& view, std::size_t offset, std::size_t width) const = 0;
+    };
+
+    template <typename Policy>
+    struct Model final : Concept {
+        explicit Model(Policy p) : policy(std::move(p)) {}
+
+        double score(const PlacementView& view, std::size_t offset, std::size_t width) const override {
+            return policy.score(view, offset, width);
+        }
+
+        Policy policy;
+    };
+
+    std::shared_ptr<const Concept> impl_;
+};
+
+// The built-in policies, by name
+enum class CostPolicyKind {
+    MIN_FRAGMENTATION,  // "min_fragmentation"
+    FIRST_FIT,          // "first_fit"
+    BEST_FIT,           // "best_fit"
+    LAST_FIT,           // "last_fit"
+    EXACT_FIT,          // "exact_fit"
+    MIN_MAX_GAP,        // "min_max_gap"
+    WORST_FIT           // "worst_fit"
+};
+
+// Number of CostPolicyKind values; follows the last enumerator
+constexpr std::size_t kCostPolicyKindCount = static_cast<std::size_t>(CostPolicyKind::WORST_FIT) + 1;
+
+const char* to_string(CostPolicyKind kind);
+
+// Throws std::runtime_error listing the known names
+CostPolicyKind parse_cost_policy(const std::string& name);
+
+// Every built-in name, in CostPolicyKind order
+const std::vector<std::string>& cost_policy_names();
+
+/*
+ *  - Runtime front end for the compile-time policies: calls f(policy) with
+ *    the concrete built-in policy for kind (weights only affect
+ *    MIN_FRAGMENTATION)
+ *  - Throws on an unknown kind
+ */
+template <typename F>
+decltype(auto) dispatch_cost_policy(
+    CostPolicyKind kind,
+    const FragmentationCostWeights& weights,
+    F&& f
+) {
+    switch (kind) {
+        case CostPolicyKind::MIN_FRAGMENTATION: return std::forward<F>(f)(MinFragmentationPolicy(weights));
+        case CostPolicyKind::FIRST_FIT:         return std::forward<F>(f)(FirstFitPolicy{});
+        case CostPolicyKind::BEST_FIT:          return std::forward<F>(f)(BestFitPolicy{});
+        case CostPolicyKind::LAST_FIT:          return std::forward<F>(f)(LastFitPolicy{});
+        case CostPolicyKind::EXACT_FIT:         return std::forward<F>(f)(ExactFitPolicy{});
+        case CostPolicyKind::MIN_MAX_GAP:       return std::forward<F>(f)(MinMaxGapPolicy{});
+        case CostPolicyKind::WORST_FIT:         return std::forward<F>(f)(WorstFitPolicy{});
+    }
+    throw std::runtime_error("Unknown cost policy");
+}
+
+// Whether kind's policy declares pick(), i.e. wants an extent-indexed engine
+bool cost_policy_picks(CostPolicyKind kind);
+
+CostPolicy make_cost_policy(CostPolicyKind kind, const FragmentationCostWeights& weights = {});
+CostPolicy make_cost_policy(const std::string& name, const FragmentationCostWeights& weights = {});
+
+} // namespace otn
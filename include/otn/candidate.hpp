@@ -1,7 +1,272 @@
 #pragma once
 
 #include "otn/odu.hpp"
+#include "otn/admission_policy.hpp"
+#include "otn/fragmentation.hpp"
+#include "otn/free_extent_index.hpp"
+#include "otn/grooming_planner.hpp"
+#include "otn/instrumentation.hpp"
+#include "otn/slot_map.hpp"
+
+#include <limits>
+#include <optional>
+#include <vector>
 
 namespace otn {
 
+/*
+ *  - Admission state for a single parent ODU
+ *  - Occupancy covers the existing grooming plus every committed admission,
+ *    so two pending children can never be booked onto the same slots
+ *  - Candidate offsets are checked against a per-level fit mask in O(1);
+ *    masks for all levels come from one FeasibilityTable, rebuilt by every
+ *    commit/release
+ *  - Placements are scored by a cost policy (admission_policy.hpp); the
+ *    default MinFragmentationPolicy uses FragmentationState::what_if (no
+ *    allocation)
+ *  - With index_extents, policies with pick() read a FreeExtentIndex that
+ *    every commit/release updates, instead of scanning; without it they scan
+ *    like any other policy and the engine pays nothing for the index
+ *  - Const methods never modify the engine, so any number of threads may
+ *    query a shared engine while none commits or releases
+ *  - Throws if the initial grooming overlaps or exceeds the parent
+ */
+class AdmissionEngine {
+public:
+    AdmissionEngine(
+        OduLevel parent_level,
+        const std::vector<GroomedChild>& current,
+        bool index_extents = true
+    );
+
+    OduLevel parent_level() const { return parent_level_; }
+    const SlotMap& occupancy() const { return occupancy_; }
+    const FragmentationState& fragmentation() const { return fragmentation_; }
+
+    // Free runs of the live occupancy (empty without index_extents)
+    bool indexes_extents() const { return index_extents_; }
+    const FreeExtentIndex& extents() const { return extents_; }
+
+    // Start offsets where a child of the given level fits right now
+    const SlotMap& feasible_mask(OduLevel child_level) const { return feasibility_.mask(child_level); }
+
+    // Fit masks for every child level against the live occupancy
+    const FeasibilityTable& feasibility() const { return feasibility_; }
+
+    PlacementView view() const { return {occupancy_, fragmentation_, extents_}; }
+
+    /*
+     *  - Picks the lowest-cost feasible offset among the candidates
+     *  - Equal costs resolve to the lowest offset
+     *  - Candidates for other children are ignored
+     */
+    template <typename Policy>
+    AdmissionResult evaluate(
+        const Odu& child,
+        const std::vector<const Candidate*>& candidates,
+        const Policy& policy
+    ) const;
+
+    AdmissionResult evaluate(
+        const Odu& child,
+        const std::vector<const Candidate*>& candidates
+    ) const;
+
+    // Same scoring over every feasible offset, without a candidate list
+    template <typename Policy>
+    AdmissionResult best_placement(const Odu& child, const Policy& policy) const;
+
+    AdmissionResult best_placement(const Odu& child) const;
+
+    // Books [offset, offset + child.slots()) for child
+    void commit(const Odu* child, std::size_t offset);
+
+    // Frees a previously committed or pre-existing placement
+    void release(std::size_t offset, std::size_t width);
+
+private:
+    OduLevel parent_level_;
+    SlotMap occupancy_;
+    FragmentationState fragmentation_;
+    bool index_extents_;
+    FreeExtentIndex extents_;
+    FeasibilityTable feasibility_;
+};
+
+template <typename Policy>
+AdmissionResult AdmissionEngine::evaluate(
+    const Odu& child,
+    const std::vector<const Candidate*>& candidates,
+    const Policy& policy
+) const {
+    OTN_COUNT(ADMISSION_EVALUATIONS);
+    OTN_TIME_SCOPE(ADMISSION);
+
+    // Feasibility is computed once per child against live occupancy
+    const SlotMap& feasible = feasible_mask(child.level());
+    const PlacementView placement_view = view();
+    const std::size_t width = child.slots();
+
+    double best_cost = std::numeric_limits<double>::infinity();
+    std::optional<std::size_t> best_offset;
+
+    // Tallied locally, published once per evaluation
+    uint64_t considered = 0;
+    uint64_t rejected = 0;
+
+    for (const Candidate* cand : candidates) {
+        if (cand->child != &child) continue;
+        ++considered;
+
+        const std::size_t offset = cand->offset;
+        if (!feasible.test(offset)) {
+            ++rejected;
+            continue;
+        }
+
+        const double cost = policy.score(placement_view, offset, width);
+
+        // preserves greedy + stable tie-breaking
+        if (
+            cost < best_cost ||
+            (cost == best_cost && (!best_offset.has_value() || offset < *best_offset))
+        ) {
+            best_cost = cost;
+            best_offset = offset;
+        }
+    }
+
+    OTN_COUNT_N(CANDIDATES_CONSIDERED, considered);
+    OTN_COUNT_N(CANDIDATES_REJECTED, rejected);
+    (void)considered;
+    (void)rejected;
+
+    if (!best_offset.has_value()) {
+        OTN_COUNT(ADMISSIONS_BLOCKED);
+        return {false, 0, best_cost};
+    }
+    OTN_COUNT(ADMISSIONS_ACCEPTED);
+    return {true, *best_offset, best_cost};
+}
+
+template <typename Policy>
+AdmissionResult AdmissionEngine::best_placement(const Odu& child, const Policy& policy) const {
+    OTN_COUNT(ADMISSION_EVALUATIONS);
+    OTN_TIME_SCOPE(ADMISSION);
+
+    const PlacementView placement_view = view();
+    const std::size_t width = child.slots();
+
+    double best_cost = std::numeric_limits<double>::infinity();
+    std::optional<std::size_t> best_offset;
+
+    if (detail::has_pick<Policy>::value && index_extents_) {
+        // Straight off the free runs, at the feasibility width; no mask needed
+        std::size_t offset = FreeExtentIndex::npos;
+        if constexpr (detail::has_pick<Policy>::value) {
+            offset = policy.pick(placement_view, tributary_slots(child.level()));
+        }
+        if (offset != FreeExtentIndex::npos) {
+            best_cost = policy.score(placement_view, offset, width);
+            best_offset = offset;
+        }
+    } else if (detail::first_feasible_wins<Policy>::value) {
+        const std::size_t offset = feasible_mask(child.level()).find_next_set(0);
+        if (offset != SlotMap::npos) {
+            best_cost = policy.score(placement_view, offset, width);
+            best_offset = offset;
+        }
+    } else {
+        const SlotMap& feasible = feasible_mask(child.level());
+
+        // Ascending scan: strict < keeps the lowest offset on ties
+        for (std::size_t offset = feasible.find_next_set(0);
+             offset != SlotMap::npos;
+             offset = feasible.find_next_set(offset + 1)) {
+            const double cost = policy.score(placement_view, offset, width);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_offset = offset;
+            }
+        }
+    }
+
+    if (!best_offset.has_value()) {
+        OTN_COUNT(ADMISSIONS_BLOCKED);
+        return {false, 0, best_cost};
+    }
+    OTN_COUNT(ADMISSIONS_ACCEPTED);
+    return {true, *best_offset, best_cost};
+}
+
+namespace detail {
+
+// Candidates grouped by child, children in first-seen order
+struct CandidateGroups {
+    std::vector<const Odu*> children;
+    std::vector<std::vector<const Candidate*>> groups;   // parallel to children
+};
+
+// Throws on a null child
+CandidateGroups group_candidates(const std::vector<Candidate>& candidates);
+
+} // namespace detail
+
+/*
+ *  - admit_candidates scored by an arbitrary cost policy
+ *  - The three-argument form is this with MinFragmentationPolicy{}
+ */
+template <typename Policy>
+std::vector<GroomedChild> admit_candidates(
+    OduLevel parent_level,
+    std::vector<GroomedChild> current,
+    const std::vector<Candidate>& candidates,
+    const Policy& policy
+) {
+    const detail::CandidateGroups grouped = detail::group_candidates(candidates);
+
+    AdmissionEngine engine(parent_level, current);
+
+    // Admitted children are appended in child order, after the existing grooming
+    current.reserve(current.size() + grouped.children.size());
+
+    // Process children in stable order; each admission is visible to the next
+    for (std::size_t i = 0; i < grouped.children.size(); ++i) {
+        const Odu* child = grouped.children[i];
+        const AdmissionResult result = engine.evaluate(*child, grouped.groups[i], policy);
+
+        if (result.admitted) {
+            engine.commit(child, result.chosen_offset);
+            current.emplace_back(child, result.chosen_offset);
+        }
+    }
+
+    return current;
+}
+
+// One independent parent: its level, current grooming and admission candidates
+struct AdmissionJob {
+    OduLevel parent_level;
+    std::vector<GroomedChild> current;
+    std::vector<Candidate> candidates;
+};
+
+/*
+ *  - Runs admit_candidates for every job on a work-stealing thread pool
+ *  - results[i] is exactly what admit_candidates would return for jobs[i]
+ *  - threads == 0 uses all hardware threads
+ *  - If jobs throw, the exception of the lowest-index failing job is rethrown
+ *  - The policy overload scores every job with the same (type-erased) policy
+ */
+std::vector<std::vector<GroomedChild>> admit_candidates_batch(
+    const std::vector<AdmissionJob>& jobs,
+    std::size_t threads = 0
+);
+
+std::vector<std::vector<GroomedChild>> admit_candidates_batch(
+    const std::vector<AdmissionJob>& jobs,
+    const CostPolicy& policy,
+    std::size_t threads = 0
+);
+
 } // namespace otn
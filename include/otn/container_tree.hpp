@@ -0,0 +1,166 @@
+#pragma once
+
+#include "otn/admission_policy.hpp"
+#include "otn/candidate.hpp"
+#include "otn/leaf_prototypes.hpp"
+#include "otn/odu.hpp"
+#include "otn/otn_types.hpp"
+#include "otn/slot_map.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace otn {
+
+using ContainerId = std::uint32_t;
+using DemandId = std::uint32_t;
+
+constexpr ContainerId kNoContainer = 0xFFFFFFFFu;
+
+struct ContainerTreeConfig {
+    CostPolicyKind policy = CostPolicyKind::MIN_FRAGMENTATION;
+    FragmentationCostWeights cost_weights{};
+    bool close_empty_containers = true;   // release() closes intermediates left empty
+};
+
+/*
+ *  - Where place() puts (or find() would put) a demand
+ *  - anchor is the existing container the placement attaches to; with
+ *    opened == 0 the demand goes straight into it at anchor_offset,
+ *    otherwise anchor_offset is where the first new intermediate opens
+ *  - Placements compare by opened, then by the policy cost at the anchor
+ */
+struct HierarchicalPlacement {
+    bool admitted = false;
+    ContainerId anchor = kNoContainer;
+    std::size_t anchor_offset = 0;
+    std::size_t opened = 0;         // intermediate containers created
+    double cost = 0.0;
+    std::size_t visited = 0;        // containers the search examined
+
+    // Set by place() only
+    DemandId demand = 0;
+    ContainerId container = kNoContainer;   // container holding the demand
+    std::size_t offset = 0;                 // slot offset inside it
+};
+
+/*
+ *  - Multi-level grooming state: root containers (e.g. one ODU4 per line),
+ *    intermediates of every lower level beneath them, and demands as leaves
+ *  - Every edge is one level down, as the grooming constructor requires;
+ *    a container always reserves its full tributary width in its parent
+ *  - place() carries a demand of any level to any depth in one call,
+ *    opening the missing intermediates (ODU1 into an ODU4 opens an ODU3
+ *    and an ODU2 when no existing ones have room)
+ *  - Reuse first: a placement into an existing container always beats one
+ *    that opens containers, fewer openings beat more, then the admission
+ *    policy's cost decides; remaining ties go to the earlier root, child
+ *    and offset
+ *  - Each container caches which demand levels fit anywhere in its subtree
+ *    (counting intermediates that could still be opened); the search skips
+ *    subtrees that cannot host the demand without entering them
+ *  - Summaries are updated along the path to the root on every change:
+ *    O(depth) per place/release
+ *  - Ids of closed containers and released demands are reused
+ */
+class ContainerTree {
+public:
+    explicit ContainerTree(ContainerTreeConfig config = {});
+
+    const ContainerTreeConfig& config() const { return config_; }
+
+    // Top-level container; roots are never closed
+    ContainerId add_root(OduLevel level);
+
+    // Existing intermediate, one level below parent, at offset; throws if it does not fit
+    ContainerId open_container(ContainerId parent, std::size_t offset);
+
+    // Existing demand, one level below container, at offset; throws if it does not fit
+    DemandId place_at(ContainerId container, std::size_t offset);
+
+    // Best placement for a demand of this level, without changing anything
+    HierarchicalPlacement find(OduLevel level) const;
+
+    // find() plus the commit: opens intermediates and books the demand
+    HierarchicalPlacement place(OduLevel level);
+
+    // Frees the demand; throws on an unknown id
+    void release(DemandId demand);
+
+    std::size_t container_count() const { return nodes_.size() - free_nodes_.size(); }
+    std::size_t demand_count() const { return demands_.size() - free_demands_.size(); }
+    const std::vector<ContainerId>& roots() const { return roots_; }
+
+    bool is_open(ContainerId id) const { return id < nodes_.size() && nodes_[id].open; }
+    OduLevel level(ContainerId id) const { return nodes_[id].level; }
+    ContainerId parent(ContainerId id) const { return nodes_[id].parent; }
+    std::size_t offset(ContainerId id) const { return nodes_[id].offset; }
+    const std::vector<ContainerId>& children(ContainerId id) const { return nodes_[id].children; }
+    const SlotMap& occupancy(ContainerId id) const { return nodes_[id].engine.occupancy(); }
+
+    // Subtree summary: a demand of this level fits somewhere below id
+    bool can_host(ContainerId id, OduLevel demand) const {
+        return (nodes_[id].host_mask >> static_cast<unsigned>(demand)) & 1u;
+    }
+
+    bool is_placed(DemandId id) const { return id < demands_.size() && demands_[id].placed; }
+    ContainerId demand_container(DemandId id) const { return demands_[id].container; }
+    std::size_t demand_offset(DemandId id) const { return demands_[id].offset; }
+
+    // Recomputes every summary from the occupancies; true if all cached ones match
+    bool verify_summaries() const;
+
+private:
+    struct Node {
+        OduLevel level;
+        ContainerId parent;
+        std::uint16_t offset;
+        bool open;
+        std::uint8_t host_mask;                       // bit L: level-L demand fits below
+        std::array<std::uint32_t, 5> hosting_children; // children whose mask has bit L
+        std::vector<ContainerId> children;
+        AdmissionEngine engine;
+    };
+
+    struct Demand {
+        ContainerId container;
+        std::uint16_t offset;
+        OduLevel level;
+        bool placed;
+    };
+
+    template <typename Policy>
+    void search(ContainerId id, OduLevel demand, const Policy& policy,
+                HierarchicalPlacement& best) const;
+
+    template <typename Policy>
+    HierarchicalPlacement find_with(OduLevel level, const Policy& policy) const;
+
+    template <typename Policy>
+    HierarchicalPlacement place_with(OduLevel level, const Policy& policy);
+
+    ContainerId new_node(OduLevel level, ContainerId parent, std::size_t offset);
+    DemandId new_demand(ContainerId container, std::size_t offset, OduLevel level);
+
+    const Odu& prototype(OduLevel level) const { return prototypes_[level]; }
+
+    std::uint8_t own_mask(const Node& node) const;
+
+    // Recomputes id's mask and pushes any change up towards the root
+    void refresh(ContainerId id);
+
+    // Closes id and any ancestors left empty (roots excluded)
+    void close_if_empty(ContainerId id);
+
+    ContainerTreeConfig config_;
+    LeafPrototypes prototypes_;      // containers only book level/slots
+    std::vector<Node> nodes_;
+    std::vector<ContainerId> free_nodes_;
+    std::vector<ContainerId> roots_;
+    std::vector<Demand> demands_;
+    std::vector<DemandId> free_demands_;
+};
+
+} // namespace otn
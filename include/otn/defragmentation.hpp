@@ -0,0 +1,74 @@
+#pragma once
+
+#include "otn/fragmentation.hpp"
+#include "otn/groomed_child.hpp"
+#include "otn/otn_types.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace otn {
+
+struct DefragTarget {
+    enum class Kind {
+        FREE_CONTIGUOUS_RUN,   // at least run_width contiguous free slots
+        COST_BELOW             // fragmentation_cost(weights) < max_cost
+    };
+
+    Kind kind;
+    std::size_t run_width = 0;
+    double max_cost = 0.0;
+    FragmentationCostWeights weights{};
+
+    static DefragTarget free_run(std::size_t width) {
+        return {Kind::FREE_CONTIGUOUS_RUN, width, 0.0, {}};
+    }
+
+    static DefragTarget cost_below(
+        double threshold,
+        const FragmentationCostWeights& weights = {}
+    ) {
+        return {Kind::COST_BELOW, 0, threshold, weights};
+    }
+};
+
+struct DefragBudget {
+    std::size_t max_moves = 8;
+    std::size_t max_nodes = 200000;
+};
+
+// Relocate one child; destination never overlaps its current slots
+struct DefragMove {
+    const Odu* child;
+    std::size_t slot_width;
+    std::size_t from_offset;
+    std::size_t to_offset;
+};
+
+struct DefragPlan {
+    std::vector<DefragMove> moves;      // apply in order
+    std::vector<GroomedChild> result;   // grooming after all moves, input order
+    bool target_met;
+    bool proven_minimal;                // no shorter sequence exists
+    std::size_t nodes_explored;
+};
+
+/*
+ *  - Finds the shortest sequence of single-child moves that reaches target
+ *  - Moves are make-before-break: each destination must be entirely free in
+ *    the occupancy left by the moves before it (including the mover's own
+ *    current slots)
+ *  - Iterative-deepening search with an admissible lower bound; layouts
+ *    already reached with fewer moves are not expanded again
+ *  - If the budget runs out first, target_met is false and no moves are
+ *    returned
+ *  - Throws if the input grooming overlaps or exceeds the parent
+ */
+DefragPlan plan_defragmentation(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    const DefragTarget& target,
+    const DefragBudget& budget = {}
+);
+
+} // namespace otn
@@ -2,9 +2,13 @@
 
 #include "groomed_child.hpp"
 #include "odu.hpp"
+#include "slot_map.hpp"
 
 #include <vector>
+#include <chrono>
 #include <cstddef>
+#include <map>
+#include <set>
 
 namespace otn {
 
@@ -27,6 +31,49 @@ FragmentationMetrics analyze_fragmentation(
     // OduLevel parent_level,
     const std::vector<GroomedChild>& grooming);
 
+// Same metrics computed straight from an occupancy bitmap
+FragmentationMetrics analyze_fragmentation(const SlotMap& occupancy);
+
+/*
+ *  - Incrementally maintained fragmentation metrics for one parent
+ *  - insert/remove are O(log n) in the number of placed children
+ *  - what_if() scores a hypothetical placement without mutating state
+ *  - metrics() always equals analyze_fragmentation() of the placed set
+ *  - Throws on zero-width or overlapping placements
+ */
+class FragmentationState {
+public:
+    FragmentationState() = default;
+    explicit FragmentationState(const std::vector<GroomedChild>& grooming);
+
+    void insert(std::size_t offset, std::size_t width);
+    void remove(std::size_t offset, std::size_t width);
+    void clear();
+
+    std::size_t placed_count() const { return placed_.size(); }
+
+    FragmentationMetrics metrics() const;
+
+    FragmentationMetrics what_if(std::size_t offset, std::size_t width) const;
+
+private:
+    using Placement = std::map<std::size_t, std::size_t>::const_iterator;
+
+    Placement check_free(std::size_t offset, std::size_t width) const;
+
+    FragmentationMetrics make_metrics(
+        std::size_t first_slot,
+        std::size_t end_slot,
+        std::size_t gap_count,
+        std::size_t total_gap_slots,
+        std::size_t max_gap
+    ) const;
+
+    std::map<std::size_t, std::size_t> placed_; // offset -> width
+    std::multiset<std::size_t> gaps_;           // interior gap lengths
+    std::size_t total_gap_slots_ = 0;
+};
+
 double fragmentation_cost(
     const FragmentationMetrics& metrics,
     const FragmentationCostWeights& weights = {}
@@ -47,4 +94,63 @@ std::vector<GroomedChild> repack_grooming_deterministic(
     const std::vector<GroomedChild>& grooming
 );
 
+/*
+ *  - Non-throwing repacks: the layout is written to out
+ *  - INSUFFICIENT_SLOTS (out left empty) where the throwing versions throw
+ */
+GroomStatus try_repack_grooming(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    std::vector<GroomedChild>& out
+);
+
+GroomStatus try_repack_grooming_size_aware(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    std::vector<GroomedChild>& out
+);
+
+GroomStatus try_repack_grooming_deterministic(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    std::vector<GroomedChild>& out
+);
+
+struct RepackBudget {
+    std::size_t max_nodes = 200000;
+    std::chrono::milliseconds time_limit{50};
+    FragmentationCostWeights weights{};
+};
+
+struct RepackReport {
+    std::vector<GroomedChild> grooming;
+    double cost;
+    bool proven_optimal;    // search finished (or hit the zero-cost bound)
+    bool used_fallback;     // budget ran out and the greedy layout won
+    std::size_t nodes_explored;
+};
+
+/*
+ *  - Exact repack: branch-and-bound over the slot bitmap
+ *  - Minimizes fragmentation_cost(budget.weights) of the final layout
+ *  - Weights are assumed non-negative, so a zero-cost layout ends the search
+ *  - (child index, occupancy mask) states are memoized so each subproblem
+ *    is expanded once
+ *  - When the node/time budget runs out the better of the incumbent and the
+ *    greedy size-aware layout is returned
+ *  - Throws if no packing exists
+ */
+RepackReport repack_grooming_optimal(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    const RepackBudget& budget = {}
+);
+
+GroomStatus try_repack_grooming_optimal(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    RepackReport& out,
+    const RepackBudget& budget = {}
+);
+
 } // namespace otn
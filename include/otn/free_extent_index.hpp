@@ -0,0 +1,94 @@
+#pragma once
+
+#include "otn/fragmentation.hpp"
+#include "otn/slot_map.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace otn {
+
+// Maximal run of free slots
+struct FreeExtent {
+    std::size_t offset;
+    std::size_t length;
+
+    bool operator==(const FreeExtent& other) const {
+        return offset == other.offset && length == other.length;
+    }
+};
+
+enum class ExtentFit {
+    FIRST,   // lowest-offset run that holds the width
+    BEST,    // shortest run that holds it (lowest offset on ties)
+    WORST    // longest run (lowest offset on ties)
+};
+
+/*
+ *  - Free runs of a slot space of any size, kept sorted three ways:
+ *    by (length, offset) for best/worst fit, by offset for coalescing, and
+ *    in a max segment tree over run starts for first fit
+ *  - allocate/release and every fit query are O(log n) in the capacity;
+ *    placements always start at the chosen run's first slot
+ *  - metrics() reads gap count, gap slots, max gap and span straight off the
+ *    runs and equals analyze_fragmentation() of the same occupancy
+ *  - Not bounded by SlotMap::kMaxSlots
+ */
+class FreeExtentIndex {
+public:
+    static constexpr std::size_t npos = SlotMap::npos;
+
+    // Everything free
+    explicit FreeExtentIndex(std::size_t capacity = 0);
+
+    // Free runs of an occupancy bitmap
+    static FreeExtentIndex from_occupancy(const SlotMap& occupancy);
+
+    std::size_t capacity() const { return capacity_; }
+    std::size_t free_slots() const { return free_slots_; }
+    std::size_t extent_count() const { return by_offset_.size(); }
+    std::size_t largest_extent() const;
+
+    // Start of the run chosen for width, or npos; width == 0 yields npos
+    std::size_t first_fit(std::size_t width) const;
+    std::size_t best_fit(std::size_t width) const;
+    std::size_t worst_fit(std::size_t width) const;
+    std::size_t fit(ExtentFit strategy, std::size_t width) const;
+
+    // Run containing slot, or {npos, 0} if the slot is occupied
+    FreeExtent extent_at(std::size_t slot) const;
+
+    bool range_free(std::size_t offset, std::size_t width) const;
+
+    // Throws unless [offset, offset + width) is free and in range
+    void allocate(std::size_t offset, std::size_t width);
+
+    // Throws if any slot of [offset, offset + width) is already free or out of range
+    void release(std::size_t offset, std::size_t width);
+
+    FragmentationMetrics metrics() const;
+
+    // Free runs in ascending offset order
+    std::vector<FreeExtent> extents() const;
+
+private:
+    void insert_extent(std::size_t offset, std::size_t length);
+    void erase_extent(std::size_t offset, std::size_t length);
+    void replace_extent(std::size_t offset, std::size_t length, std::size_t new_offset, std::size_t new_length);
+    void set_leaf(std::size_t offset, std::size_t length);
+
+    std::size_t capacity_;
+    std::size_t free_slots_;
+    std::set<std::pair<std::size_t, std::size_t>> by_length_;   // (length, offset)
+    std::map<std::size_t, std::size_t> by_offset_;              // offset -> length
+
+    // Leaf i: length of the run starting at slot i (0 if none); inner nodes: max
+    std::size_t leaves_;
+    std::vector<std::uint32_t> tree_;
+};
+
+} // namespace otn
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "otn/odu.hpp"
+#include "otn/slot_map.hpp"
+#include <array>
 #include <vector>
 
 namespace otn {
@@ -17,6 +19,17 @@ plan_grooming(
     const std::vector<Odu>& children
 );
 
+/*
+ *  - Non-throwing plan_grooming: the grooming is written to out
+ *  - out is cleared first and left empty unless the status is OK; its
+ *    capacity is reused, so a warm vector means no allocation
+ */
+GroomStatus try_plan_grooming(
+    OduLevel parent_level,
+    const std::vector<Odu>& children,
+    std::vector<GroomedChild>& out
+);
+
 
 /* std::vector<GroomedChild>
 repack_grooming(
@@ -31,6 +44,23 @@ repack_grooming_size_aware(
     const std::vector<GroomedChild>& current
 ); */
 
+/*
+ *  - Word-packed occupancy of the parent's tributary slots
+ *  - Throws on out-of-range or overlapping children
+ */
+SlotMap occupied_slot_map(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming
+);
+
+// Non-throwing occupied_slot_map (out is only valid when OK; INVALID_HIERARCHY
+// for a parent level outside ODU1..ODU4)
+GroomStatus try_occupied_slot_map(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    SlotMap& out
+);
+
 /*
  *  - Marks slots as open or closed based on whether child occupies them
  */
@@ -39,6 +69,12 @@ std::vector<bool> occupied_slots(
     const std::vector<GroomedChild>& grooming
 );
 
+GroomStatus try_occupied_slots(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    std::vector<bool>& out
+);
+
 /*
  *  - Returns all slot offsets where candidate can be placed
  *  - No overlaps and within parent capacity
@@ -49,6 +85,54 @@ std::vector<size_t> feasible_offsets(
     const Odu& candidate
 );
 
+/*
+ *  - Same answer as feasible_offsets, as a bitmask: bit i set iff the
+ *    candidate fits at offset i
+ *  - Skips building the offset list; use SlotMap::write_offsets for a
+ *    compact list without allocation
+ */
+SlotMap feasible_offset_mask(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    const Odu& candidate
+);
+
+/*
+ *  - Fit masks for every child level of one grooming state, computed from
+ *    a single occupancy map: the 4-slot mask extends the 1-slot mask, the
+ *    16-slot mask extends the 4-slot one, and so on
+ *  - Reusable across any number of candidates until the grooming changes;
+ *    call rebuild() (or construct a new table) after it does
+ */
+class FeasibilityTable {
+public:
+    // Throws like occupied_slot_map on out-of-range or overlapping children
+    FeasibilityTable(OduLevel parent_level, const std::vector<GroomedChild>& grooming);
+    FeasibilityTable(OduLevel parent_level, const SlotMap& occupancy);
+
+    void rebuild(const SlotMap& occupancy);
+
+    OduLevel parent_level() const { return parent_level_; }
+    const SlotMap& occupancy() const { return occupancy_; }
+
+    // Bit i set iff a child of this level fits at offset i (empty if too wide)
+    const SlotMap& mask(OduLevel child_level) const;
+
+    bool fits(OduLevel child_level, std::size_t offset) const;
+    std::vector<std::size_t> offsets(OduLevel child_level) const;
+
+private:
+    OduLevel parent_level_;
+    SlotMap occupancy_;
+    std::array<SlotMap, 5> masks_;  // indexed by child OduLevel value
+};
+
+// feasible_offsets against a prebuilt table (no occupancy reconstruction)
+std::vector<size_t> feasible_offsets(
+    const FeasibilityTable& table,
+    const Odu& candidate
+);
+
 struct AdmissionResult {
     bool admitted;
     size_t chosen_offset;
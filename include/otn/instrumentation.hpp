@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*
+ *  - Compile-time switch: build with OTN_INSTRUMENTATION=0 (CMake option
+ *    OTN_INSTRUMENTATION=OFF) and every OTN_COUNT / OTN_TIME_SCOPE in the
+ *    library compiles to nothing
+ *  - The snapshot/dump API stays available either way (all zeros when off)
+ */
+#ifndef OTN_INSTRUMENTATION
+#define OTN_INSTRUMENTATION 0
+#endif
+
+namespace otn {
+namespace instr {
+
+enum class Counter : uint8_t {
+    PLAN_GROOMING,
+    PLAN_GROOMING_BLOCKED,      // try_plan_grooming ran out of slots
+    OCCUPIED_SLOTS,
+    FEASIBLE_OFFSETS,
+    FEASIBLE_OFFSETS_EMPTY,     // no offset fits the candidate
+    FEASIBILITY_TABLE_BUILDS,
+    ANALYZE_FRAGMENTATION,
+    REPACK,
+    REPACK_BLOCKED,
+    REPACK_OPTIMAL,
+    REPACK_OPTIMAL_NODES,       // branch-and-bound nodes explored
+    ADMISSION_EVALUATIONS,
+    CANDIDATES_CONSIDERED,
+    CANDIDATES_REJECTED,        // offset not feasible against occupancy
+    ADMISSIONS_ACCEPTED,
+    ADMISSIONS_BLOCKED,
+    ODU_AGGREGATIONS,
+    ODU_AGGREGATIONS_FAILED,
+    MUX_CALLS,
+    MUX_FAILURES,
+    COUNT_
+};
+
+enum class Timer : uint8_t {
+    PLAN_GROOMING,
+    FEASIBLE_OFFSETS,
+    ANALYZE_FRAGMENTATION,
+    REPACK,
+    REPACK_OPTIMAL,
+    ADMISSION,
+    ODU_AGGREGATION,
+    COUNT_
+};
+
+constexpr std::size_t kCounterCount = static_cast<std::size_t>(Counter::COUNT_);
+constexpr std::size_t kTimerCount   = static_cast<std::size_t>(Timer::COUNT_);
+
+// Bucket b holds latencies in [2^b, 2^(b+1)) ns; bucket 0 also holds 0 ns
+constexpr std::size_t kHistogramBuckets = 40;
+
+struct Histogram {
+    std::array<uint64_t, kHistogramBuckets> buckets{};
+    uint64_t count = 0;
+    uint64_t sum_ns = 0;
+    uint64_t max_ns = 0;
+
+    double mean_ns() const;
+
+    // Upper bound of the bucket containing quantile q (0..1)
+    uint64_t quantile_ns(double q) const;
+};
+
+struct Snapshot {
+    std::array<uint64_t, kCounterCount> counters{};
+    std::array<Histogram, kTimerCount> timers{};
+
+    uint64_t counter(Counter c) const { return counters[static_cast<std::size_t>(c)]; }
+    const Histogram& timer(Timer t) const { return timers[static_cast<std::size_t>(t)]; }
+};
+
+const char* name(Counter c);
+const char* name(Timer t);
+
+/*
+ *  - Recording touches only the calling thread's block: no locks, no
+ *    shared cache lines; threads register once on first use
+ *  - Blocks of exited threads are folded into a retired total
+ *  - Calls from thread_local destructors that run after the thread's block
+ *    was retired are dropped
+ */
+void add(Counter c, uint64_t n = 1);
+void record(Timer t, uint64_t ns);
+
+// Sum over all live and exited threads
+Snapshot snapshot();
+
+// Zeroes every block; updates racing with the reset may survive it
+void reset();
+
+std::string to_json(const Snapshot& s);
+std::string to_prometheus(const Snapshot& s);  // text exposition format
+
+/*
+ *  - Scoped timers measure one call in every `period` per thread and timer;
+ *    the clock reads cost more than the probed kernels themselves
+ *  - Counters are never sampled, so they stay exact
+ *  - A period of 1 times every call
+ */
+constexpr uint32_t kDefaultTimerSamplePeriod = 64;
+
+void set_timer_sample_period(uint32_t period);
+uint32_t timer_sample_period();
+
+namespace detail {
+
+extern std::atomic<uint32_t> sample_period;
+inline thread_local std::array<uint32_t, kTimerCount> sample_ticks{};
+
+inline bool sample(Timer t) {
+    uint32_t& tick = sample_ticks[static_cast<std::size_t>(t)];
+    if (++tick < sample_period.load(std::memory_order_relaxed)) return false;
+    tick = 0;
+    return true;
+}
+
+} // namespace detail
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Timer t) : timer_(t), active_(detail::sample(t)) {
+        if (active_) start_ = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedTimer() {
+        if (!active_) return;
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        record(timer_, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+        ));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Timer timer_;
+    bool active_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace instr
+} // namespace otn
+
+#define OTN_INSTR_CONCAT_(a, b) a##b
+#define OTN_INSTR_CONCAT(a, b) OTN_INSTR_CONCAT_(a, b)
+
+#if OTN_INSTRUMENTATION
+#define OTN_COUNT(c) ::otn::instr::add(::otn::instr::Counter::c)
+#define OTN_COUNT_N(c, n) ::otn::instr::add(::otn::instr::Counter::c, (n))
+#define OTN_TIME_SCOPE(t) \
+    ::otn::instr::ScopedTimer OTN_INSTR_CONCAT(otn_scoped_timer_, __LINE__)(::otn::instr::Timer::t)
+#else
+#define OTN_COUNT(c) ((void)0)
+#define OTN_COUNT_N(c, n) ((void)0)
+#define OTN_TIME_SCOPE(t) ((void)0)
+#endif
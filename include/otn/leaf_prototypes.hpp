@@ -0,0 +1,29 @@
+#pragma once
+
+#include "otn/odu.hpp"
+#include "otn/otn_types.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace otn {
+
+/*
+ *  - One zero-payload leaf per ODU level (ODU1..ODU4), for code that only
+ *    books placements by level and width
+ *  - Leaves never move once built, so GroomedChild pointers to them stay valid
+ *  - level must be a valid OduLevel; not checked
+ */
+class LeafPrototypes {
+public:
+    LeafPrototypes();
+
+    const Odu& operator[](OduLevel level) const {
+        return leaves_[static_cast<std::size_t>(level) - static_cast<std::size_t>(OduLevel::ODU1)];
+    }
+
+private:
+    std::vector<Odu> leaves_;
+};
+
+} // namespace otn
@@ -0,0 +1,273 @@
+#pragma once
+
+#include "otn/groomed_child.hpp"
+#include "otn/otn_types.hpp"
+#include "otn/slot_map.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace otn {
+
+namespace detail {
+
+// Narrowest unsigned word that holds Bits slots (64-bit words beyond that)
+template <std::size_t Bits>
+using slot_word_t =
+    std::conditional_t<(Bits <= 8),  std::uint8_t,
+    std::conditional_t<(Bits <= 16), std::uint16_t,
+    std::conditional_t<(Bits <= 32), std::uint32_t,
+                                     std::uint64_t>>>;
+
+} // namespace detail
+
+/*
+ *  - SlotMap with the capacity fixed at compile time
+ *  - Word type and word count follow from N: an ODU2 map is one byte, an
+ *    ODU3 map one 16-bit word, an ODU4 map two 64-bit words
+ *  - All loops run over a constant word count, so they unroll completely
+ *  - Bits at or beyond N are always zero
+ */
+template <std::size_t N>
+class FixedSlotMap {
+public:
+    static_assert(N > 0 && N <= SlotMap::kMaxSlots, "Unsupported slot count");
+
+    using Word = detail::slot_word_t<N>;
+
+    static constexpr std::size_t kSlots    = N;
+    static constexpr std::size_t kWordBits = sizeof(Word) * 8;
+    static constexpr std::size_t kWords    = (N + kWordBits - 1) / kWordBits;
+
+    using Words = std::array<Word, kWords>;
+
+    static constexpr std::size_t capacity() { return N; }
+    constexpr const Words& words() const { return words_; }
+
+    constexpr std::size_t count() const {
+        std::size_t n = 0;
+        for (std::size_t w = 0; w < kWords; ++w) {
+            n += static_cast<std::size_t>(__builtin_popcountll(words_[w]));
+        }
+        return n;
+    }
+
+    constexpr bool none() const {
+        for (std::size_t w = 0; w < kWords; ++w) {
+            if (words_[w] != 0) return false;
+        }
+        return true;
+    }
+
+    constexpr bool test(std::size_t slot) const {
+        return slot < N && ((words_[slot / kWordBits] >> (slot % kWordBits)) & 1u);
+    }
+
+    // True if [offset, offset + width) lies within N and is entirely clear
+    constexpr bool range_free(std::size_t offset, std::size_t width) const {
+        if (offset > N || width > N - offset) return false;
+        for (std::size_t w = 0; w < kWords; ++w) {
+            if (words_[w] & range_word(w, offset, width)) return false;
+        }
+        return true;
+    }
+
+    // Caller guarantees [offset, offset + width) lies within N
+    constexpr void set_range(std::size_t offset, std::size_t width) {
+        for (std::size_t w = 0; w < kWords; ++w) {
+            words_[w] |= range_word(w, offset, width);
+        }
+    }
+
+    constexpr void clear_range(std::size_t offset, std::size_t width) {
+        for (std::size_t w = 0; w < kWords; ++w) {
+            words_[w] &= static_cast<Word>(~range_word(w, offset, width));
+        }
+    }
+
+    // Bit i of the result is set iff [i, i + width) is free and in range
+    constexpr FixedSlotMap fit_mask(std::size_t width) const {
+        FixedSlotMap result;
+        if (width == 0 || width > N) return result;
+
+        Words free{};
+        for (std::size_t w = 0; w < kWords; ++w) {
+            free[w] = static_cast<Word>(~words_[w] & range_word(w, 0, N));
+        }
+
+        // Run doubling, as in SlotMap::fit_mask
+        result.words_ = free;
+        std::size_t run = 1;
+        while (run < width) {
+            const std::size_t step = run < width - run ? run : width - run;
+            const Words shifted = shift_right(result.words_, step);
+            for (std::size_t w = 0; w < kWords; ++w) {
+                result.words_[w] &= shifted[w];
+            }
+            run += step;
+        }
+        return result;
+    }
+
+    // Lowest set slot at or after from, or SlotMap::npos
+    constexpr std::size_t find_next_set(std::size_t from = 0) const {
+        for (std::size_t w = from / kWordBits; w < kWords; ++w) {
+            std::uint64_t v = words_[w];
+            if (w == from / kWordBits) {
+                v &= ~std::uint64_t{0} << (from % kWordBits);
+            }
+            if (v != 0) {
+                return w * kWordBits + static_cast<std::size_t>(__builtin_ctzll(v));
+            }
+        }
+        return SlotMap::npos;
+    }
+
+    constexpr std::size_t find_first_fit(std::size_t width, std::size_t from = 0) const {
+        if (width == 0) return from <= N ? from : SlotMap::npos;
+        return fit_mask(width).find_next_set(from);
+    }
+
+    // Set positions appended in ascending order
+    void append_offsets(std::vector<std::size_t>& out) const {
+        out.reserve(out.size() + count());
+        for (std::size_t w = 0; w < kWords; ++w) {
+            std::uint64_t v = words_[w];
+            while (v != 0) {
+                out.push_back(w * kWordBits + static_cast<std::size_t>(__builtin_ctzll(v)));
+                v &= v - 1;
+            }
+        }
+    }
+
+    SlotMap to_slot_map() const {
+        SlotMap::Words packed{};
+        for (std::size_t w = 0; w < kWords; ++w) {
+            const std::size_t bit = w * kWordBits;
+            packed[bit / SlotMap::kWordBits] |=
+                static_cast<std::uint64_t>(words_[w]) << (bit % SlotMap::kWordBits);
+        }
+        return SlotMap::from_words(N, packed);
+    }
+
+    static FixedSlotMap from_slot_map(const SlotMap& map) {
+        FixedSlotMap result;
+        for (std::size_t w = 0; w < kWords; ++w) {
+            const std::size_t bit = w * kWordBits;
+            result.words_[w] = static_cast<Word>(
+                (map.words()[bit / SlotMap::kWordBits] >> (bit % SlotMap::kWordBits)) &
+                range_word(w, 0, N)
+            );
+        }
+        return result;
+    }
+
+    constexpr bool operator==(const FixedSlotMap& other) const {
+        for (std::size_t w = 0; w < kWords; ++w) {
+            if (words_[w] != other.words_[w]) return false;
+        }
+        return true;
+    }
+    constexpr bool operator!=(const FixedSlotMap& other) const { return !(*this == other); }
+
+private:
+    // Bits of word w covered by [offset, offset + width)
+    static constexpr Word range_word(std::size_t w, std::size_t offset, std::size_t width) {
+        const std::size_t base = w * kWordBits;
+        const std::size_t end  = offset + width;
+        if (end <= base || offset >= base + kWordBits) return 0;
+
+        const std::size_t lo = offset > base ? offset - base : 0;
+        const std::size_t hi = end - base >= kWordBits ? kWordBits : end - base;
+
+        const std::uint64_t upper =
+            hi >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << hi) - 1;
+        return static_cast<Word>(upper & ~((std::uint64_t{1} << lo) - 1));
+    }
+
+    // words >> shift, treating the array as one little-endian integer
+    static constexpr Words shift_right(const Words& in, std::size_t shift) {
+        Words out{};
+        const std::size_t word_shift = shift / kWordBits;
+        const std::size_t bit_shift  = shift % kWordBits;
+
+        for (std::size_t w = 0; w + word_shift < kWords; ++w) {
+            std::uint64_t v = static_cast<std::uint64_t>(in[w + word_shift]) >> bit_shift;
+            if (bit_shift != 0 && w + word_shift + 1 < kWords) {
+                v |= static_cast<std::uint64_t>(in[w + word_shift + 1]) << (kWordBits - bit_shift);
+            }
+            out[w] = static_cast<Word>(v);
+        }
+        return out;
+    }
+
+    Words words_{};
+};
+
+// Slot map sized for a parent ODU level (1, 4, 16 or 80 slots)
+template <OduLevel Level>
+using LevelSlotMap = FixedSlotMap<tributary_slots(Level)>;
+
+template <OduLevel Level>
+using LevelTag = std::integral_constant<OduLevel, Level>;
+
+/*
+ *  - Runtime front end for the per-level kernels: calls f(LevelTag<L>{})
+ *    for the matching compile-time level
+ *  - Throws on a level outside ODU1..ODU4
+ */
+template <typename F>
+decltype(auto) dispatch_level(OduLevel level, F&& f) {
+    switch (level) {
+        case OduLevel::ODU1: return std::forward<F>(f)(LevelTag<OduLevel::ODU1>{});
+        case OduLevel::ODU2: return std::forward<F>(f)(LevelTag<OduLevel::ODU2>{});
+        case OduLevel::ODU3: return std::forward<F>(f)(LevelTag<OduLevel::ODU3>{});
+        case OduLevel::ODU4: return std::forward<F>(f)(LevelTag<OduLevel::ODU4>{});
+    }
+    throw std::runtime_error("Unknown ODU level");
+}
+
+// ---------------- GROOMING KERNELS ----------------
+
+// Occupancy of a parent's slots from its grooming (see try_occupied_slot_map)
+template <OduLevel Parent>
+GroomStatus fill_occupancy(
+    const std::vector<GroomedChild>& grooming,
+    LevelSlotMap<Parent>& out
+) {
+    constexpr std::size_t max_slots = tributary_slots(Parent);
+    out = {};
+
+    for (const auto& g : grooming) {
+        if (g.slot_offset + g.slot_width > max_slots) {
+            return GroomStatus::SLOT_OUT_OF_RANGE;
+        }
+        if (!out.range_free(g.slot_offset, g.slot_width)) {
+            return GroomStatus::OVERLAPPING_SLOTS;
+        }
+        out.set_range(g.slot_offset, g.slot_width);
+    }
+    return GroomStatus::OK;
+}
+
+// Feasible start offsets for a width-slot child, appended ascending
+template <OduLevel Parent>
+GroomStatus feasible_offsets_kernel(
+    const std::vector<GroomedChild>& grooming,
+    std::size_t width,
+    std::vector<std::size_t>& out
+) {
+    LevelSlotMap<Parent> occupied;
+    const GroomStatus status = fill_occupancy<Parent>(grooming, occupied);
+    if (status == GroomStatus::OK) {
+        occupied.fit_mask(width).append_offsets(out);
+    }
+    return status;
+}
+
+} // namespace otn
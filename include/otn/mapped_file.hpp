@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace otn {
+
+/*
+ *  - Read-only private memory mapping of a whole file
+ *  - An empty file gives an empty range (mmap rejects zero-length maps)
+ *  - Move-only; unmaps on destruction
+ *  - Throws std::runtime_error if the file cannot be opened or mapped
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return static_cast<const char*>(data_); }
+    std::size_t size() const { return bytes_; }
+    bool empty() const { return bytes_ == 0; }
+
+    // Read-ahead hint for front-to-back scans
+    void advise_sequential() const;
+
+    // Drops resident pages wholly inside [0, bytes); they fault back in if read again
+    void release_prefix(std::size_t bytes) const;
+
+private:
+    void unmap() noexcept;
+
+    void* data_ = nullptr;
+    std::size_t bytes_ = 0;
+};
+
+} // namespace otn
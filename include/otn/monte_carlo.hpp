@@ -0,0 +1,66 @@
+#pragma once
+
+#include "otn/simulation.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace otn {
+
+// Sample statistics over independent replications
+struct Estimate {
+    double mean = 0.0;
+    double stddev = 0.0;         // sample standard deviation
+    double ci_half_width = 0.0;  // 95% confidence interval (Student t)
+    std::size_t samples = 0;
+
+    double lower() const { return mean - ci_half_width; }
+    double upper() const { return mean + ci_half_width; }
+};
+
+struct MonteCarloConfig {
+    SimulationConfig base;           // arrival_rate and seed are overridden
+    std::vector<double> loads;       // offered load in Erlangs per load point
+    std::size_t replications = 16;   // independent seeds per load point
+    uint64_t base_seed = 1;
+    std::size_t threads = 0;         // 0 = hardware concurrency
+};
+
+struct LoadPointResult {
+    double offered_load = 0.0;
+
+    Estimate blocking;
+    Estimate utilization;
+    Estimate fragmentation_cost;     // time-averaged, per replication
+
+    // Indexed by OduLevel value; only replications with arrivals of that
+    // level contribute a sample
+    std::array<Estimate, 5> blocking_per_level{};
+    std::array<uint64_t, 5> arrivals_per_level{};
+    std::array<uint64_t, 5> blocked_per_level{};
+};
+
+struct MonteCarloResult {
+    std::vector<LoadPointResult> points;  // same order as config.loads
+    uint64_t total_events = 0;
+};
+
+// Seed of one replication: splitmix64 over (base, load point, replication)
+uint64_t replication_seed(uint64_t base_seed, std::size_t load_index, std::size_t replication);
+
+// Summary of samples, accumulated in the given order
+Estimate estimate(const std::vector<double>& samples);
+
+/*
+ *  - Runs config.replications simulations per load point on parallel_for
+ *  - Replication seeds depend only on (base_seed, load point, replication),
+ *    never on the worker that runs them
+ *  - Each replication writes its own preallocated slot; the reduction runs
+ *    afterwards in index order, so results are bit-identical for any
+ *    thread count
+ */
+MonteCarloResult run_monte_carlo(const MonteCarloConfig& config);
+
+} // namespace otn
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "otn_types.hpp"
+#include <array>
 #include <cstddef>
 #include <vector>
 #include "opu.hpp"
@@ -10,6 +11,17 @@ namespace otn {
 
 class Odu;  
 
+/*
+ *  - Aggregate properties of the subtree rooted at an ODU
+ *  - Computed once at construction from the children's cached summaries
+ */
+struct SubtreeSummary {
+    size_t leaf_count = 0;
+    size_t depth = 0;                        // 0 for a leaf
+    size_t leaf_payload_bytes = 0;
+    std::array<size_t, 5> leaves_per_level{}; // indexed by OduLevel value
+};
+
 class Odu {
 public:
     // Leaf ODU (originating from client payload / OPU)
@@ -30,11 +42,55 @@ public:
     Odu(OduLevel level, std::vector<GroomedChild> groomed_children); //grooming constructor (mandatory)
     const std::vector<GroomedChild>& groomed_children() const; //grooming introspection
 
+    /*
+     *  - Non-throwing grooming constructor: out is assigned only when OK
+     *  - Same checks and statuses the grooming constructor throws on
+     */
+    static GroomStatus try_groom(
+        OduLevel level,
+        std::vector<GroomedChild> groomed_children,
+        Odu& out
+    );
+
+    // Message the grooming constructor throws for a failed status
+    static const char* grooming_error(GroomStatus status);
+
+    // Cached subtree summary: O(1), no tree walk
+    const SubtreeSummary& summary() const;
+    size_t leaf_count() const;
+    size_t depth() const;
+
+    /*
+     *  - Children are non-owning pointers; if one changes after this ODU was
+     *    built, refresh bottom-up: refresh_summary() recombines the direct
+     *    children's cached summaries, payload and slot totals
+     *  - compute_summary() walks the whole subtree and ignores all caches
+     */
+    void refresh_summary();
+    static SubtreeSummary compute_summary(const Odu& root);
+
 private:
+    friend class OduMux;
+
+    // Trusted aggregation: grooming and totals were validated incrementally
+    Odu(OduLevel level, std::vector<GroomedChild> groomed_children,
+        size_t payload_bytes, size_t slot_count);
+
+    SubtreeSummary summarize_children() const;
+
+    // Hierarchy, range and overlap checks; fills the totals when OK
+    static GroomStatus check_grooming(
+        OduLevel level,
+        const std::vector<GroomedChild>& groomed_children,
+        size_t& payload_bytes,
+        size_t& slot_count
+    );
+
     OduLevel level_;
     size_t payload_bytes_;
     size_t slot_count_;
     std::vector<GroomedChild> groomed_children_;
+    SubtreeSummary summary_;
 };
 
 MuxResult mux(
@@ -2,22 +2,39 @@
 
 #include "otn_types.hpp"
 #include "odu.hpp"
+#include "free_extent_index.hpp"
+#include "slot_map.hpp"
 
+#include <unordered_map>
 #include <vector>
 
 namespace otn {
 
+/*
+ *  - Streaming multiplexer: clients arrive and leave one at a time
+ *  - Slot bitmap and capacity/payload counters are updated per add/remove,
+ *    so can_accept/add_client never rescan existing clients
+ *  - Clients are placed first-fit by default, or best/worst-fit from a
+ *    FreeExtentIndex kept alongside the bitmap (only for those strategies)
+ *  - Clients are held by pointer (like GroomedChild): they must outlive the
+ *    mux and any ODU produced by multiplex()
+ */
 class OduMux {
 public:
-    explicit OduMux(OduLevel target_level);
+    explicit OduMux(OduLevel target_level, ExtentFit fit = ExtentFit::FIRST);
 
     MuxResult add_client(const Odu& client);
+    MuxResult remove_client(const Odu& client);
     bool can_accept(const Odu& client) const;
 
     bool is_full() const;
     size_t used_capacity() const;
     size_t remaining_capacity() const;
+    size_t client_count() const;
 
+    const std::vector<GroomedChild>& grooming() const;
+
+    // Builds the parent from the already-validated grooming; throws if empty
     Odu multiplex() const;
     void reset();
 
@@ -25,11 +42,23 @@ private:
     bool is_valid_client(const Odu& client) const;
     size_t capacity_for_level(OduLevel level) const;
 
+    // Offset chosen by fit_ for width, cached until the next add/remove
+    size_t find_offset(size_t width) const;
+
 private:
     OduLevel target_level_;
+    ExtentFit fit_;
     size_t max_capacity_;
     size_t used_capacity_;
-    std::vector<Odu> clients_;
+    size_t payload_bytes_;
+    SlotMap occupancy_;
+    FreeExtentIndex extents_;
+    std::vector<GroomedChild> clients_;
+    std::vector<size_t> client_payloads_;   // payload_size() when added, parallel to clients_
+    std::unordered_map<const Odu*, size_t> client_index_;
+
+    mutable size_t cached_width_;
+    mutable size_t cached_offset_;
 };
 
 } // namespace otn
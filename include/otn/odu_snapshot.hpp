@@ -0,0 +1,105 @@
+#pragma once
+
+#include "otn/mapped_file.hpp"
+#include "otn/odu_store.hpp"
+#include "otn/otn_types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace otn {
+
+/*
+ *  - On-disk layout of an OduStore snapshot
+ *  - Fixed header followed by the store's arrays verbatim, each starting on
+ *    an 8-byte boundary, in this order:
+ *      payload_bytes  uint64[odu_count]
+ *      children       StoredChild[child_count]
+ *      first_child    uint32[odu_count]
+ *      level          uint8[odu_count]
+ *      slot_count     uint8[odu_count]
+ *      child_count    uint8[odu_count]
+ *  - Native byte order; endian_tag rejects files written on a host of the
+ *    other endianness
+ *  - Bump kSnapshotVersion on any layout change
+ */
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endian_tag;
+    std::uint64_t file_bytes;
+    std::uint64_t odu_count;
+    std::uint64_t child_count;
+    std::uint64_t payload_bytes_offset;
+    std::uint64_t children_offset;
+    std::uint64_t first_child_offset;
+    std::uint64_t level_offset;
+    std::uint64_t slot_count_offset;
+    std::uint64_t child_count_offset;
+};
+
+static_assert(sizeof(SnapshotHeader) == 88, "Snapshot header layout changed");
+static_assert(sizeof(StoredChild) == 8, "Snapshot child record layout changed");
+static_assert(sizeof(OduLevel) == 1, "Snapshot level record layout changed");
+
+constexpr char kSnapshotMagic[8] = {'O', 'T', 'N', 'S', 'N', 'A', 'P', '\0'};
+constexpr std::uint32_t kSnapshotVersion = 1;
+constexpr std::uint32_t kSnapshotEndianTag = 0x01020304;
+
+// Header (magic, version, sizes, offsets) for a store of the given size
+SnapshotHeader snapshot_layout(std::size_t odu_count, std::size_t child_count);
+
+/*
+ *  - Read-only view of a snapshot file mapped into memory
+ *  - Opening checks the header only (magic, version, byte order, file size,
+ *    section offsets); no per-node parsing and no allocation, so it costs
+ *    the same for 10 or 10 million ODUs
+ *  - Accessors mirror OduStore; pages are faulted in on first touch
+ *  - verify() walks every node once and applies the OduStore grooming
+ *    rules, for files that did not come from a trusted writer
+ *  - Throws std::runtime_error on any malformed file
+ */
+class MappedSnapshot {
+public:
+    using ChildRange = OduStore::ChildRange;
+
+    explicit MappedSnapshot(const std::string& path);
+
+    MappedSnapshot(MappedSnapshot&& other) noexcept;
+    MappedSnapshot& operator=(MappedSnapshot&& other) noexcept;
+
+    std::size_t size() const { return odu_count_; }
+    std::size_t child_link_count() const { return child_count_total_; }
+    std::size_t file_bytes() const { return file_.size(); }
+
+    OduLevel level(OduHandle h) const { return level_[h.index]; }
+    std::size_t payload_size(OduHandle h) const { return payload_bytes_[h.index]; }
+    std::size_t slots(OduHandle h) const { return slot_count_[h.index]; }
+    bool is_aggregated(OduHandle h) const { return child_count_[h.index] != 0; }
+    ChildRange children(OduHandle h) const {
+        const StoredChild* base = children_ + first_child_[h.index];
+        return {base, base + child_count_[h.index]};
+    }
+
+    bool contains(OduHandle h) const { return h.index < odu_count_; }
+
+    void verify() const;
+
+private:
+    friend class OduStore;
+
+    MappedFile file_;
+
+    std::size_t odu_count_ = 0;
+    std::size_t child_count_total_ = 0;
+
+    const std::uint64_t* payload_bytes_ = nullptr;
+    const StoredChild* children_ = nullptr;
+    const std::uint32_t* first_child_ = nullptr;
+    const OduLevel* level_ = nullptr;
+    const std::uint8_t* slot_count_ = nullptr;
+    const std::uint8_t* child_count_ = nullptr;
+};
+
+} // namespace otn
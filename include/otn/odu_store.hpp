@@ -0,0 +1,104 @@
+#pragma once
+
+#include "otn/odu.hpp"
+#include "otn/otn_types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace otn {
+
+class MappedSnapshot;
+
+// Stable 32-bit reference to an ODU inside an OduStore
+struct OduHandle {
+    std::uint32_t index;
+
+    bool operator==(const OduHandle& other) const { return index == other.index; }
+    bool operator!=(const OduHandle& other) const { return index != other.index; }
+};
+
+// Requested placement of an existing ODU inside a new aggregate
+struct ChildPlacement {
+    OduHandle child;
+    std::size_t slot_offset;
+};
+
+// Groomed child as stored in the arena (8 bytes)
+struct StoredChild {
+    OduHandle child;
+    std::uint16_t slot_width;
+    std::uint16_t slot_offset;
+};
+
+/*
+ *  - Arena for every ODU of a network, stored structure-of-arrays
+ *  - Nodes are referenced by 32-bit handles that stay valid as the store grows
+ *  - An aggregate's children sit in one contiguous block of the child array
+ *  - Validation matches the Odu leaf and grooming constructors (throws)
+ *  - clear() drops the whole hierarchy at once; all arrays are trivially
+ *    destructible
+ */
+class OduStore {
+public:
+    struct ChildRange {
+        const StoredChild* first;
+        const StoredChild* last;
+
+        const StoredChild* begin() const { return first; }
+        const StoredChild* end() const { return last; }
+        std::size_t size() const { return static_cast<std::size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+
+    void reserve(std::size_t odus, std::size_t children);
+
+    OduHandle add_leaf(OduLevel level, std::size_t payload_bytes);
+    OduHandle add_aggregate(OduLevel level, const std::vector<ChildPlacement>& children);
+
+    // Deep-copies an Odu tree, children first
+    OduHandle import(const Odu& odu);
+
+    /*
+     *  - Binary snapshot (layout in odu_snapshot.hpp), written in one pass
+     *  - load() verifies a mapped snapshot, then copies it back into a
+     *    mutable store: one bulk copy per array, handles unchanged; throws
+     *    like MappedSnapshot::verify() on a corrupt file
+     */
+    void save(std::ostream& out) const;
+    void save(const std::string& path) const;
+    static OduStore load(const MappedSnapshot& snapshot);
+    static OduStore load(const std::string& path);
+
+    std::size_t size() const { return level_.size(); }
+    std::size_t child_link_count() const { return children_.size(); }
+
+    OduLevel level(OduHandle h) const { return level_[h.index]; }
+    std::size_t payload_size(OduHandle h) const { return payload_bytes_[h.index]; }
+    std::size_t slots(OduHandle h) const { return slot_count_[h.index]; }
+    bool is_aggregated(OduHandle h) const { return child_count_[h.index] != 0; }
+    ChildRange children(OduHandle h) const;
+
+    bool contains(OduHandle h) const { return h.index < level_.size(); }
+
+    // Bytes held by the arrays (capacity, not size)
+    std::size_t memory_bytes() const;
+
+    void clear();
+
+private:
+    OduHandle push_node(OduLevel level, std::size_t payload_bytes, std::size_t slots,
+                        std::size_t first_child, std::size_t child_count);
+
+    std::vector<OduLevel> level_;
+    std::vector<std::uint64_t> payload_bytes_;
+    std::vector<std::uint8_t> slot_count_;
+    std::vector<std::uint32_t> first_child_;
+    std::vector<std::uint8_t> child_count_;
+    std::vector<StoredChild> children_;
+};
+
+} // namespace otn
@@ -5,9 +5,11 @@ namespace otn {
 
 class Opu {
 public:
+    // Payload copies are cheap: size-only or a shared buffer
     explicit Opu(const Payload& payload);
 
     size_t payload_size() const;
+    const Payload& payload() const;
 
 private:
     Payload payload_;
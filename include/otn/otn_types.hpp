@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -12,7 +13,16 @@ enum class OduLevel : uint8_t {
     ODU4 = 4
 };
 
-size_t nominal_capacity(OduLevel level);
+// Payload bytes a leaf ODU of this level can carry
+constexpr size_t nominal_capacity(OduLevel level) {
+    switch (level) {
+        case OduLevel::ODU1: return 2500;
+        case OduLevel::ODU2: return 10000;
+        case OduLevel::ODU3: return 40000;
+        case OduLevel::ODU4: return 100000;
+    }
+    return 0; // undefined OTN level
+}
 
 enum class MuxStatus {
     SUCCESS,
@@ -20,23 +30,48 @@ enum class MuxStatus {
     INSUFFICIENT_CAPACITY
 };
 
+/*
+ *  - Outcome of the non-throwing grooming, repack and aggregation calls
+ *  - A plain enum: no allocation on either the success or failure path
+ */
+enum class GroomStatus : uint8_t {
+    OK,
+    MIXED_CHILD_LEVELS,
+    INVALID_HIERARCHY,
+    INSUFFICIENT_SLOTS,     // parent is full: the ordinary blocking outcome
+    SLOT_OUT_OF_RANGE,
+    OVERLAPPING_SLOTS
+};
+
+// Static description of a status (never allocates)
+const char* to_string(GroomStatus status);
+
 struct MuxResult {
     MuxStatus status;
-    std::string message;
+    const char* message;    // static string, never owned
 
     static MuxResult success() {
         return {MuxStatus::SUCCESS, "OK"};
     }
 
-    static MuxResult invalid_hierarchy(const std::string& msg) {
+    static MuxResult invalid_hierarchy(const char* msg) {
         return {MuxStatus::INVALID_HIERARCHY, msg};
     }
 
-    static MuxResult insufficient_capacity(const std::string& msg) {
+    static MuxResult insufficient_capacity(const char* msg) {
         return {MuxStatus::INSUFFICIENT_CAPACITY, msg};
     }
 };
 
-size_t tributary_slots(OduLevel level);
+// Tributary slots of an ODU of this level (also its width as a child)
+constexpr size_t tributary_slots(OduLevel level) {
+    switch (level) {
+        case OduLevel::ODU1: return 1;
+        case OduLevel::ODU2: return 4;
+        case OduLevel::ODU3: return 16;
+        case OduLevel::ODU4: return 80;
+    }
+    return 0;
+}
 
 } // namespace otn
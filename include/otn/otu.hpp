@@ -1,18 +1,25 @@
 #pragma once
 #include "odu.hpp"
 
+#include <memory>
+
 namespace otn {
 
 class Otu {
 public:
+    // Takes a snapshot of odu (copied once, then shared between Otu copies)
     Otu(const Odu& odu, bool fec_enabled);
 
+    // Zero-copy: shares an ODU the caller already owns
+    Otu(std::shared_ptr<const Odu> odu, bool fec_enabled);
+
     bool fec_enabled() const;
     OduLevel odu_level() const;
     size_t payload_size() const;
+    const Odu& odu() const;
 
 private:
-    Odu odu_;
+    std::shared_ptr<const Odu> odu_;
     bool fec_enabled_;
 };
 
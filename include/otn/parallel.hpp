@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace otn {
+
+/*
+ *  - Runs task(i) for every i in [0, count) on a pool of worker threads
+ *  - Each worker starts with a contiguous block of indices and pops from
+ *    its front; an idle worker steals the back half of a busy worker's block
+ *  - threads == 0 uses std::thread::hardware_concurrency()
+ *  - Every index runs exactly once even if some tasks throw; afterwards the
+ *    exception from the lowest failing index is rethrown
+ */
+void parallel_for(
+    std::size_t count,
+    std::size_t threads,
+    const std::function<void(std::size_t)>& task
+);
+
+// Worker count parallel_for would use for the given request
+std::size_t resolve_thread_count(std::size_t requested, std::size_t count);
+
+} // namespace otn
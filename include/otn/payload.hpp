@@ -1,18 +1,36 @@
 #pragma once
 #include <vector>
+#include <memory>
 #include <cstdint>
 #include <cstddef>
 
 namespace otn {
 
+/*
+ *  - Size-only by default: only the byte count is stored, nothing is allocated
+ *  - Byte-backed payloads share an immutable buffer, so copies never copy bytes
+ */
 class Payload {
 public:
+    using Buffer = std::shared_ptr<const std::vector<uint8_t>>;
+
     explicit Payload(size_t size);
 
+    // Zero-copy view of an existing buffer; null buffer means size 0
+    explicit Payload(Buffer bytes);
+
+    // Allocates a real zero-filled buffer of size bytes
+    static Payload zero_filled(size_t size);
+
     size_t size() const;
 
+    bool has_bytes() const;
+    const uint8_t* data() const; // nullptr for size-only payloads
+    const Buffer& buffer() const;
+
 private:
-    std::vector<uint8_t> data_;
+    size_t size_;
+    Buffer bytes_;
 };
 
 } // namespace otn
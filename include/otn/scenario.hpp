@@ -0,0 +1,99 @@
+#pragma once
+
+#include "otn/monte_carlo.hpp"
+#include "otn/simulation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace otn {
+
+enum class ScenarioMode {
+    SIMULATE,   // one Simulator run
+    SWEEP,      // Monte Carlo over loads x replications
+    REPLAY,     // demand trace through TraceReplayer
+    ROUTE       // random demands routed over a topology file
+};
+
+/*
+ *  - Everything otn_sim needs to run one experiment
+ *  - sim carries the parent pool, demand mix, admission and repack
+ *    policies, traffic and seed for SIMULATE/SWEEP; REPLAY uses its parent
+ *    pool and admission policy; ROUTE its demand mix and seed
+ *  - threads only affects SWEEP (0 = all hardware threads)
+ */
+struct Scenario {
+    ScenarioMode mode = ScenarioMode::SIMULATE;
+    SimulationConfig sim;
+
+    std::vector<double> loads = {100.0};   // SWEEP, offered Erlangs
+    std::size_t replications = 16;         // SWEEP
+    std::size_t threads = 0;               // SWEEP
+
+    std::string trace;                     // REPLAY, CSV or binary trace
+    std::string topology;                  // ROUTE, edge-list file
+    std::size_t route_demands = 10000;     // ROUTE
+    std::size_t k_paths = 3;               // ROUTE
+};
+
+/*
+ *  - Scenario file: one "key = value" per line; blank lines and # comments
+ *    are ignored, later keys override earlier ones
+ *  - Keys:
+ *    - mode: simulate | sweep | replay | route
+ *    - parent_level, parents: level and number of parent ODUs
+ *    - demand_mix: ODU1:0.8, ODU2:0.2; levels below parent_level
+ *    - policy: any cost_policy_names() entry
+ *    - cost_weights: gap_count:0.3, max_gap:0; others keep their defaults
+ *    - repack: none | size_aware | deterministic | optimal
+ *    - repack_max_nodes: node budget of the cost_weights-optimal repack
+ *    - arrival_rate, holding_time, arrivals, warmup, seed: simulation
+ *    - threads, loads (comma list), replications: sweep
+ *    - trace: replay input
+ *    - topology, demands, k_paths: route
+ *  - Relative trace/topology paths resolve against base_dir
+ *  - Throws std::runtime_error naming the offending line or key
+ */
+Scenario parse_scenario(std::istream& in, const std::string& base_dir = "");
+Scenario load_scenario(const std::string& path);
+
+// Applies one key/value pair (also used for command-line overrides)
+void apply_scenario_setting(
+    Scenario& scenario,
+    const std::string& key,
+    const std::string& value,
+    const std::string& base_dir = ""
+);
+
+const char* to_string(ScenarioMode mode);
+const char* to_string(SimRepackPolicy policy);
+
+struct ScenarioReport {
+    double wall_seconds = 0.0;
+    uint64_t operations = 0;         // events, trace records or routed demands
+    const char* operation_unit = "events";
+
+    double blocking = 0.0;
+    double mean_utilization = 0.0;
+    double mean_fragmentation = 0.0;    // time-averaged (SIMULATE, SWEEP)
+    double final_fragmentation = 0.0;   // at the end (SIMULATE, REPLAY, ROUTE)
+    uint64_t repacks = 0;
+    uint64_t repack_admissions = 0;
+
+    std::vector<LoadPointResult> points;   // SWEEP only
+
+    double operations_per_second() const {
+        return wall_seconds > 0.0 ? static_cast<double>(operations) / wall_seconds : 0.0;
+    }
+};
+
+// Runs the scenario end to end; wall time covers loading inputs as well
+ScenarioReport run_scenario(const Scenario& scenario);
+
+void print_report(std::ostream& out, const Scenario& scenario, const ScenarioReport& report);
+
+} // namespace otn
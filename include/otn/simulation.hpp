@@ -0,0 +1,170 @@
+#pragma once
+
+#include "otn/candidate.hpp"
+#include "otn/fragmentation.hpp"
+#include "otn/leaf_prototypes.hpp"
+#include "otn/odu.hpp"
+#include "otn/otn_types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace otn {
+
+// ---------------- EVENT QUEUE ----------------
+
+enum class EventType : uint8_t {
+    ARRIVAL,
+    DEPARTURE
+};
+
+struct Event {
+    double time;
+    uint64_t sequence;  // insertion order, breaks ties between equal times
+    EventType type;
+    uint32_t demand;
+};
+
+/*
+ *  - Binary min-heap on (time, sequence)
+ *  - Equal-time events pop in insertion order, so runs are reproducible
+ *  - No allocation per event once the heap has reached its working size
+ */
+class EventQueue {
+public:
+    void reserve(std::size_t events);
+
+    void push(double time, EventType type, uint32_t demand);
+    Event pop();
+    const Event& top() const { return heap_.front(); }
+
+    bool empty() const { return heap_.empty(); }
+    std::size_t size() const { return heap_.size(); }
+    void clear();
+
+private:
+    std::vector<Event> heap_;
+    uint64_t next_sequence_ = 0;
+};
+
+// ---------------- SIMULATOR ----------------
+
+// Placement objective of each admission (admission_policy.hpp)
+using SimAdmissionPolicy = CostPolicyKind;
+
+// What happens when no parent can admit an arrival as-is
+enum class SimRepackPolicy {
+    NONE,           // the arrival is blocked
+    SIZE_AWARE,     // repack_grooming_size_aware
+    DETERMINISTIC,  // repack_grooming_deterministic
+    OPTIMAL         // repack_grooming_optimal within repack_budget
+};
+
+struct DemandClass {
+    OduLevel level;
+    double weight;
+};
+
+// Throws std::runtime_error unless every class grooms strictly below parent_level
+void check_demand_mix(OduLevel parent_level, const std::vector<DemandClass>& mix);
+
+struct SimulationConfig {
+    OduLevel parent_level = OduLevel::ODU4;
+    std::size_t parent_count = 1;
+    std::vector<DemandClass> demand_mix = {{OduLevel::ODU1, 1.0}};
+    SimAdmissionPolicy policy = SimAdmissionPolicy::MIN_FRAGMENTATION;
+    FragmentationCostWeights cost_weights{};   // MIN_FRAGMENTATION objective
+    SimRepackPolicy repack = SimRepackPolicy::NONE;
+    RepackBudget repack_budget{};
+
+    double arrival_rate = 1.0;        // Poisson arrivals per unit time
+    double mean_holding_time = 1.0;   // exponential holding times
+    uint64_t arrivals = 100000;       // stop after this many arrivals
+    uint64_t warmup_arrivals = 0;     // excluded from all statistics
+    uint64_t seed = 1;
+};
+
+struct SimulationStats {
+    uint64_t arrivals = 0;
+    uint64_t blocked = 0;
+    uint64_t departures = 0;
+    uint64_t events = 0;              // including warm-up
+
+    double blocking_probability = 0.0;
+    double mean_utilization = 0.0;         // time-averaged, occupied / capacity
+    double mean_fragmentation_cost = 0.0;  // time-averaged, mean over parents
+    double final_fragmentation_cost = 0.0; // mean over parents at the end
+    double simulated_time = 0.0;           // measured period (after warm-up)
+
+    uint64_t repacks = 0;                  // parents repacked for blocked arrivals
+    uint64_t repack_admissions = 0;        // arrivals admitted only after a repack
+
+    std::array<uint64_t, 5> arrivals_per_level{};  // indexed by OduLevel value
+    std::array<uint64_t, 5> blocked_per_level{};
+};
+
+/*
+ *  - Event-driven simulation of demand arrival, hold and teardown
+ *  - Arrivals try each parent in order and take the first that admits them
+ *  - With a repack policy, an arrival no parent admits repacks the parents
+ *    in order (those with enough free slots) until one admits it
+ *  - Placement and fragmentation tracking go through AdmissionEngine; the
+ *    admission policy is dispatched to its compile-time form per arrival
+ *  - Reported fragmentation costs always use the default weights, so runs
+ *    with different policies stay comparable
+ *  - Deterministic for a given config (seeded std::mt19937_64)
+ */
+class Simulator {
+public:
+    explicit Simulator(SimulationConfig config);
+
+    SimulationStats run();
+
+private:
+    struct Demand {
+        uint32_t parent;
+        uint16_t offset;
+        uint16_t width;
+        uint8_t level;
+        bool active;
+    };
+
+    bool admit(Demand& demand);
+    bool place(uint32_t p, Demand& demand);
+    void repack(uint32_t p);
+    void release(Demand& demand);
+    void update_cost(uint32_t p);
+
+    // Adds value * dt for the current state to the running time integrals
+    void advance_clock(double now);
+
+    uint32_t allocate_demand();
+
+    SimulationConfig config_;
+    LeafPrototypes prototypes_;          // demands only need level/slots
+    std::vector<AdmissionEngine> parents_;
+    std::vector<double> parent_cost_;
+    double total_cost_ = 0.0;
+    std::size_t occupied_slots_ = 0;
+
+    std::vector<Demand> demands_;
+    std::vector<uint32_t> free_demands_;
+    EventQueue queue_;
+
+    // Repack scratch, reused across blocked arrivals
+    std::vector<GroomedChild> repack_in_;
+    std::vector<GroomedChild> repack_out_;
+    std::array<std::vector<uint32_t>, 5> repack_ids_;   // by OduLevel value
+    uint64_t repacks_ = 0;
+    uint64_t repack_admissions_ = 0;
+
+    bool measuring_ = false;
+    double clock_ = 0.0;
+    double measure_start_ = 0.0;
+    double utilization_area_ = 0.0;
+    double cost_area_ = 0.0;
+};
+
+} // namespace otn
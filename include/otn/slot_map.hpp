@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace otn {
+
+/*
+ *  - Fixed-capacity tributary slot bitmap
+ *  - Slots are packed into 64-bit words (80 slots for ODU4 fit in two)
+ *  - Occupancy, overlap and contiguous-run checks work a word at a time
+ *  - Bits at or beyond capacity() are always zero
+ */
+class SlotMap {
+public:
+    static constexpr std::size_t kWordBits = 64;
+    static constexpr std::size_t kWords    = 2;
+    static constexpr std::size_t kMaxSlots = kWords * kWordBits;
+    static constexpr std::size_t npos      = static_cast<std::size_t>(-1);
+
+    using Words = std::array<std::uint64_t, kWords>;
+
+    // Throws if capacity exceeds kMaxSlots
+    explicit SlotMap(std::size_t capacity = 0);
+
+    // Adopts packed words; bits at or beyond capacity are dropped
+    static SlotMap from_words(std::size_t capacity, const Words& words);
+
+    std::size_t capacity() const { return capacity_; }
+    const Words& words() const { return words_; }
+
+    // Number of set slots (popcount)
+    std::size_t count() const;
+    std::size_t free_count() const { return capacity_ - count(); }
+
+    // Set slots within [offset, offset + width)
+    std::size_t count_range(std::size_t offset, std::size_t width) const;
+    bool none() const;
+
+    bool test(std::size_t slot) const;
+
+    // True if [offset, offset + width) lies within capacity and is entirely clear
+    bool range_free(std::size_t offset, std::size_t width) const;
+
+    // Caller guarantees [offset, offset + width) lies within capacity
+    void set_range(std::size_t offset, std::size_t width);
+    void clear_range(std::size_t offset, std::size_t width);
+
+    bool overlaps(const SlotMap& other) const;
+
+    // Clear slots within capacity become set and vice versa
+    SlotMap complement() const;
+
+    /*
+     *  - Bit i of the result is set iff [i, i + width) is free and in range
+     *  - width == 0 yields an empty mask
+     *  - One pass of ~log2(width) word-wide shift-ANDs (run doubling)
+     */
+    SlotMap fit_mask(std::size_t width) const;
+
+    /*
+     *  - This map must be a fit mask for runs of length run; returns the
+     *    fit mask for width >= run (fit_mask(w) == complement().extend_runs(1, w))
+     *  - Lets masks for several widths share work: fit_mask(4) feeds
+     *    extend_runs(4, 16), which feeds extend_runs(16, 80)
+     */
+    SlotMap extend_runs(std::size_t run, std::size_t width) const;
+
+    // Lowest offset >= from where a free run of width starts, or npos
+    std::size_t find_first_fit(std::size_t width, std::size_t from = 0) const;
+
+    // Lowest set slot at or after from, or npos
+    std::size_t find_next_set(std::size_t from = 0) const;
+
+    // Highest set slot below before, or npos
+    std::size_t find_prev_set(std::size_t before) const;
+
+    // Positions of set slots in ascending order
+    std::vector<std::size_t> to_offsets() const;
+
+    /*
+     *  - Compact form of to_offsets(): one byte per set slot, no allocation
+     *  - out must have room for count() entries (kMaxSlots always suffices)
+     *  - Returns the number of offsets written
+     */
+    std::size_t write_offsets(std::uint8_t* out) const;
+
+    std::vector<bool> to_vector() const;
+
+    bool operator==(const SlotMap& other) const;
+    bool operator!=(const SlotMap& other) const { return !(*this == other); }
+
+private:
+    Words words_;
+    std::size_t capacity_;
+};
+
+} // namespace otn
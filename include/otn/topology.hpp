@@ -0,0 +1,159 @@
+#pragma once
+
+#include "otn/otn_types.hpp"
+#include "otn/slot_map.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace otn {
+
+using NodeId = uint32_t;
+using LinkId = uint32_t;
+
+/*
+ *  - Bidirectional OTUk link between two nodes
+ *  - Carries one ODUk grooming container: occupancy is its slot map
+ *  - version changes on every reserve/release (used for cache invalidation)
+ */
+struct Link {
+    NodeId a;
+    NodeId b;
+    OduLevel level;
+    double weight;
+    SlotMap occupancy;
+    uint64_t version;
+
+    NodeId other(NodeId n) const { return n == a ? b : a; }
+};
+
+class Topology {
+public:
+    NodeId add_node(const std::string& name);
+    LinkId add_link(NodeId a, NodeId b, OduLevel level, double weight = 1.0);
+
+    /*
+     *  - Edge list: one "src dst level [weight]" per line
+     *  - level is ODUk, OTUk or just k; nodes are created on first use
+     *  - Blank lines and lines starting with # are ignored
+     *  - Throws on malformed lines
+     */
+    static Topology from_edge_list(std::istream& in);
+    static Topology from_edge_list_file(const std::string& path);
+
+    std::size_t node_count() const { return names_.size(); }
+    std::size_t link_count() const { return links_.size(); }
+
+    const Link& link(LinkId id) const { return links_[id]; }
+    const std::vector<LinkId>& links_at(NodeId n) const { return adjacency_[n]; }
+
+    const std::string& node_name(NodeId n) const { return names_[n]; }
+    NodeId node_id(const std::string& name) const; // throws if unknown
+
+    // Slot bookkeeping on one link
+    bool reserve(LinkId id, std::size_t offset, std::size_t width);
+    void release(LinkId id, std::size_t offset, std::size_t width);
+
+private:
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, NodeId> by_name_;
+    std::vector<Link> links_;
+    std::vector<std::vector<LinkId>> adjacency_;
+};
+
+struct Path {
+    std::vector<NodeId> nodes;
+    std::vector<LinkId> links;
+    double cost;
+};
+
+// A path plus the tributary slot offset used on every hop
+struct Route {
+    std::vector<LinkId> links;
+    std::vector<uint16_t> offsets;
+    std::size_t slot_width;
+    double cost;
+};
+
+/*
+ *  - Path-based ODU router over a Topology
+ *  - k loopless shortest paths per node pair (Yen), cached per pair and
+ *    extended lazily: the i-th path is only computed once the first i are
+ *    blocked for some demand
+ *  - Spur searches are A* with the exact unblocked distance to the
+ *    destination as heuristic, so they stay close to the original path
+ *  - Per link, the first-fit offset for each ODU width is cached until the
+ *    link's slot map changes
+ *  - A route uses the cheapest path on which every hop can carry the demand
+ *    (link wide enough, first-fit offset chosen per hop)
+ *  - The topology may keep growing: once its node or link count changes,
+ *    the next query drops every cached path and distance (earlier paths()
+ *    references become invalid)
+ */
+class Router {
+public:
+    Router(Topology& topology, std::size_t k = 3);
+
+    // All k paths (fewer if the graph has fewer), cheapest first
+    const std::vector<Path>& paths(NodeId src, NodeId dst);
+
+    std::optional<Route> find_route(NodeId src, NodeId dst, OduLevel demand);
+
+    // find_route + reserve in one step
+    std::optional<Route> route_and_reserve(NodeId src, NodeId dst, OduLevel demand);
+
+    void reserve(const Route& route);
+    void release(const Route& route);
+
+private:
+    struct PairPaths {
+        std::vector<Path> accepted;
+        std::vector<Path> candidates;   // Yen's spur paths not yet accepted
+        bool exhausted = false;
+    };
+
+    struct LinkCache {
+        uint64_t version = UINT64_MAX;
+        std::array<std::size_t, 5> first_fit{}; // by demand OduLevel value
+    };
+
+    // Drops the path and distance caches if the topology has grown
+    void sync_graph();
+
+    PairPaths& pair(NodeId src, NodeId dst);
+
+    // Computes the next path of the pair; false once no more exist or k reached
+    bool extend(PairPaths& pp, NodeId src, NodeId dst);
+
+    // Unblocked distance from every node to dst, cached per destination
+    const std::vector<double>& distances_to(NodeId dst);
+
+    // A* over the unblocked links, guided by distances_to(dst)
+    std::optional<Path> shortest_path(NodeId src, NodeId dst);
+
+    std::size_t first_fit(LinkId id, OduLevel demand);
+
+    Topology& topology_;
+    std::size_t k_;
+    std::unordered_map<uint64_t, PairPaths> path_cache_;
+    std::unordered_map<NodeId, std::vector<double>> distance_cache_;
+    std::vector<LinkCache> link_cache_;
+
+    // Topology size the path and distance caches were built against
+    std::size_t graph_nodes_ = 0;
+    std::size_t graph_links_ = 0;
+
+    // Dijkstra scratch, reused across calls
+    std::vector<double> dist_;
+    std::vector<LinkId> via_;
+    std::vector<bool> blocked_nodes_;
+    std::vector<bool> blocked_links_;
+};
+
+} // namespace otn
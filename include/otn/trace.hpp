@@ -0,0 +1,243 @@
+#pragma once
+
+#include "otn/bounded_queue.hpp"
+#include "otn/candidate.hpp"
+#include "otn/leaf_prototypes.hpp"
+#include "otn/mapped_file.hpp"
+#include "otn/otn_types.hpp"
+#include "otn/simulation.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace otn {
+
+// ---------------- RECORDS ----------------
+
+enum class TraceOp : uint8_t {
+    ADD,
+    REMOVE
+};
+
+constexpr uint32_t kNoPreferredParent = 0xFFFFFFFFu;
+
+/*
+ *  - One demand event; a REMOVE only needs timestamp and demand_id
+ *  - Also the on-disk record of binary traces (32 bytes, native order)
+ */
+struct TraceRecord {
+    double timestamp = 0.0;
+    uint64_t demand_id = 0;
+    uint64_t payload_bytes = 0;
+    uint32_t preferred_parent = kNoPreferredParent;
+    TraceOp op = TraceOp::ADD;
+    OduLevel level = OduLevel::ODU1;
+    uint8_t reserved[2] = {};
+};
+
+static_assert(sizeof(TraceRecord) == 32, "Binary trace record layout changed");
+
+/*
+ *  - Binary trace: this header, then packed TraceRecords to end of file
+ *  - CSV trace, one event per line:
+ *      timestamp,op,demand_id,level,payload_bytes[,preferred_parent]
+ *    op is add/remove, level ODU1..ODU4 (or 1..4); a remove may leave
+ *    level and payload empty, preferred_parent may be empty or omitted
+ *  - CSV blank lines and '#' comments are skipped, as is a header line
+ */
+struct TraceFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian_tag;
+    uint32_t record_bytes;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(TraceFileHeader) == 24, "Binary trace header layout changed");
+
+constexpr char kTraceMagic[8] = {'O', 'T', 'N', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t kTraceVersion = 1;
+
+enum class TraceFormat {
+    AUTO,    // binary if the file starts with kTraceMagic, CSV otherwise
+    CSV,
+    BINARY
+};
+
+// Streams records into a binary trace file; throws on I/O errors
+class BinaryTraceWriter {
+public:
+    explicit BinaryTraceWriter(const std::string& path);
+
+    void write(const TraceRecord& record);
+    void close();
+
+    uint64_t records_written() const { return written_; }
+
+private:
+    std::ofstream out_;
+    uint64_t written_ = 0;
+};
+
+// ---------------- READER ----------------
+
+struct TraceReaderOptions {
+    TraceFormat format = TraceFormat::AUTO;
+    std::size_t chunk_records = 8192;   // records per parsed chunk
+    std::size_t queue_chunks = 8;       // parsed chunks buffered ahead of the consumer
+};
+
+/*
+ *  - Memory-maps the trace and parses it on a background thread, one chunk
+ *    at a time, into a bounded queue; the consumer never sees raw bytes
+ *  - At most queue_chunks + 2 chunks of records exist at once, and parsed
+ *    pages of the mapping are dropped as the parser moves on, so memory
+ *    stays flat however large the trace is
+ *  - Records are validated while parsing: known level, payload within the
+ *    level's nominal capacity, non-decreasing timestamps
+ *  - A parse error is rethrown by next()/next_chunk() after every record
+ *    before it has been delivered ("Trace line N: ..." / "Trace record N: ...")
+ *  - Single consumer; destroying the reader early stops the parser
+ */
+class TraceReader {
+public:
+    explicit TraceReader(const std::string& path, TraceReaderOptions options = {});
+    ~TraceReader();
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    TraceFormat format() const { return format_; }
+    std::size_t file_bytes() const { return file_.size(); }
+
+    // Next record in file order; false at the end of the trace
+    bool next(TraceRecord& out);
+
+    // Replaces chunk with the next parsed chunk (its old buffer is reused); false at the end
+    bool next_chunk(std::vector<TraceRecord>& chunk);
+
+    // Records handed to the consumer so far
+    uint64_t records_delivered() const { return delivered_; }
+
+private:
+    struct Chunk {
+        std::vector<TraceRecord> records;
+        std::exception_ptr error;
+    };
+
+    void produce();
+    void parse_csv(std::vector<TraceRecord>& buffer);
+    void parse_binary(std::vector<TraceRecord>& buffer);
+
+    // Hands a full buffer to the consumer; false if the reader is shutting down
+    bool emit(std::vector<TraceRecord>& buffer);
+    std::vector<TraceRecord> fresh_buffer();
+
+    bool pop_chunk(std::vector<TraceRecord>& chunk);
+
+    TraceReaderOptions options_;
+    MappedFile file_;
+    TraceFormat format_;
+
+    BoundedQueue<Chunk> ready_;
+    BoundedQueue<std::vector<TraceRecord>> recycled_;
+
+    // Consumer side
+    std::vector<TraceRecord> current_;
+    std::size_t current_pos_ = 0;
+    uint64_t delivered_ = 0;
+    bool finished_ = false;
+
+    // Started at the end of the constructor
+    std::thread parser_;
+};
+
+// ---------------- REPLAY ----------------
+
+struct ReplayConfig {
+    OduLevel parent_level = OduLevel::ODU4;
+    std::size_t parent_count = 1;
+    SimAdmissionPolicy policy = SimAdmissionPolicy::MIN_FRAGMENTATION;
+    FragmentationCostWeights cost_weights{};
+};
+
+struct ReplayStats {
+    uint64_t records = 0;
+    uint64_t adds = 0;
+    uint64_t removes = 0;
+    uint64_t admitted = 0;
+    uint64_t blocked = 0;
+    uint64_t preferred_parent_hits = 0;   // admitted on the requested parent
+    uint64_t unknown_removes = 0;         // demand not active (blocked or never added)
+    uint64_t duplicate_adds = 0;          // demand id already active; ignored
+
+    double blocking_probability = 0.0;
+    double mean_utilization = 0.0;          // time-averaged over the trace
+    double final_utilization = 0.0;
+    double final_fragmentation_cost = 0.0;  // mean over parents at the end
+    double trace_duration = 0.0;            // last minus first timestamp
+
+    std::array<uint64_t, 5> adds_per_level{};     // indexed by OduLevel value
+    std::array<uint64_t, 5> blocked_per_level{};
+};
+
+/*
+ *  - Applies trace records to a pool of parent ODUs, one AdmissionEngine
+ *    per parent (the incremental form of admit_candidates)
+ *  - ADD tries the preferred parent first, then the others in order;
+ *    placement follows the policy as in Simulator
+ *  - REMOVE releases the demand's slots
+ *  - ADD of a level not below parent_level throws std::runtime_error
+ */
+class TraceReplayer {
+public:
+    explicit TraceReplayer(ReplayConfig config);
+
+    void apply(const TraceRecord& record);
+
+    // Counters plus derived ratios as of the last applied record
+    ReplayStats stats() const;
+
+    const AdmissionEngine& parent(std::size_t i) const { return parents_[i]; }
+    std::size_t active_demands() const { return active_.size(); }
+
+private:
+    struct Placement {
+        uint32_t parent;
+        uint16_t offset;
+        uint16_t width;
+    };
+
+    bool admit(const TraceRecord& record, Placement& placement);
+    bool try_parent(uint32_t p, const Odu& child, Placement& placement);
+    void update_cost(uint32_t p);
+    void advance_clock(double now);
+
+    ReplayConfig config_;
+    LeafPrototypes prototypes_;          // placement only needs level/slots
+    std::vector<AdmissionEngine> parents_;
+    std::vector<double> parent_cost_;
+    double total_cost_ = 0.0;
+    std::size_t occupied_slots_ = 0;
+
+    std::unordered_map<uint64_t, Placement> active_;
+
+    bool started_ = false;
+    double first_time_ = 0.0;
+    double clock_ = 0.0;
+    double utilization_area_ = 0.0;
+
+    ReplayStats stats_;
+};
+
+// Drains the reader through a TraceReplayer
+ReplayStats replay_trace(TraceReader& reader, const ReplayConfig& config);
+
+} // namespace otn
@@ -0,0 +1,60 @@
+#include "otn/admission_policy.hpp"
+
+#include <stdexcept>
+
+namespace otn {
+
+const char* to_string(CostPolicyKind kind) {
+    switch (kind) {
+        case CostPolicyKind::MIN_FRAGMENTATION: return "min_fragmentation";
+        case CostPolicyKind::FIRST_FIT:         return "first_fit";
+        case CostPolicyKind::BEST_FIT:          return "best_fit";
+        case CostPolicyKind::LAST_FIT:          return "last_fit";
+        case CostPolicyKind::EXACT_FIT:         return "exact_fit";
+        case CostPolicyKind::MIN_MAX_GAP:       return "min_max_gap";
+        case CostPolicyKind::WORST_FIT:         return "worst_fit";
+    }
+    return "unknown";
+}
+
+const std::vector<std::string>& cost_policy_names() {
+    static const std::vector<std::string> names = {
+        to_string(CostPolicyKind::MIN_FRAGMENTATION),
+        to_string(CostPolicyKind::FIRST_FIT),
+        to_string(CostPolicyKind::BEST_FIT),
+        to_string(CostPolicyKind::LAST_FIT),
+        to_string(CostPolicyKind::EXACT_FIT),
+        to_string(CostPolicyKind::MIN_MAX_GAP),
+        to_string(CostPolicyKind::WORST_FIT),
+    };
+    return names;
+}
+
+CostPolicyKind parse_cost_policy(const std::string& name) {
+    const auto& names = cost_policy_names();
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) return static_cast<CostPolicyKind>(i);
+    }
+
+    std::string known;
+    for (const auto& n : names) {
+        known += known.empty() ? n : ", " + n;
+    }
+    throw std::runtime_error("Unknown admission policy: " + name + " (known: " + known + ")");
+}
+
+bool cost_policy_picks(CostPolicyKind kind) {
+    return dispatch_cost_policy(kind, {}, [](const auto& policy) {
+        return detail::has_pick<std::decay_t<decltype(policy)>>::value;
+    });
+}
+
+CostPolicy make_cost_policy(CostPolicyKind kind, const FragmentationCostWeights& weights) {
+    return dispatch_cost_policy(kind, weights, [](auto policy) { return CostPolicy(policy); });
+}
+
+CostPolicy make_cost_policy(const std::string& name, const FragmentationCostWeights& weights) {
+    return make_cost_policy(parse_cost_policy(name), weights);
+}
+
+} // namespace otn
@@ -1,25 +1,68 @@
 #include "otn/grooming_planner.hpp"
 #include "otn/candidate.hpp"
 #include "otn/fragmentation.hpp"
+#include "otn/instrumentation.hpp"
+#include "otn/parallel.hpp"
 
 #include <stdexcept>
-#include <limits>
 #include <unordered_map>
-#include <optional>
+#include <utility>
 
 namespace otn {
 
-std::vector<GroomedChild>
-admit_candidates(
+// ---------------- ADMISSION ENGINE ----------------
+
+AdmissionEngine::AdmissionEngine(
     OduLevel parent_level,
-    std::vector<GroomedChild> current,
-    const std::vector<Candidate>& candidates
-) {
-    std::unordered_map<const Odu*, std::vector<const Candidate*>> by_child;
-    std::vector<const Odu*> child_order;
+    const std::vector<GroomedChild>& current,
+    bool index_extents
+)
+    : parent_level_(parent_level),
+      occupancy_(occupied_slot_map(parent_level, current)),
+      fragmentation_(current),
+      index_extents_(index_extents),
+      extents_(index_extents ? FreeExtentIndex::from_occupancy(occupancy_) : FreeExtentIndex()),
+      feasibility_(parent_level, occupancy_)
+{}
+
+AdmissionResult AdmissionEngine::evaluate(
+    const Odu& child,
+    const std::vector<const Candidate*>& candidates
+) const {
+    return evaluate(child, candidates, MinFragmentationPolicy{});
+}
+
+AdmissionResult AdmissionEngine::best_placement(const Odu& child) const {
+    return best_placement(child, MinFragmentationPolicy{});
+}
+
+void AdmissionEngine::commit(const Odu* child, std::size_t offset) {
+    const std::size_t width = child->slots();
+
+    if (!occupancy_.range_free(offset, width)) {
+        throw std::runtime_error("Admission overlaps occupied tributary slots");
+    }
+
+    occupancy_.set_range(offset, width);
+    fragmentation_.insert(offset, width);
+    if (index_extents_) extents_.allocate(offset, width);
+    feasibility_.rebuild(occupancy_);
+}
+
+void AdmissionEngine::release(std::size_t offset, std::size_t width) {
+    fragmentation_.remove(offset, width);
+    occupancy_.clear_range(offset, width);
+    if (index_extents_) extents_.release(offset, width);
+    feasibility_.rebuild(occupancy_);
+}
 
-    // Accumulate children to add after processing all candidates
-    std::vector<GroomedChild> to_add;
+// ---------------- BATCH ADMISSION ----------------
+
+namespace detail {
+
+CandidateGroups group_candidates(const std::vector<Candidate>& candidates) {
+    CandidateGroups grouped;
+    std::unordered_map<const Odu*, std::size_t> index;
 
     // Group candidates by child, preserving first-seen order
     for (const auto& c : candidates) {
@@ -27,54 +70,56 @@ admit_candidates(
             throw std::runtime_error("Null candidate child");
         }
 
-        auto& group = by_child[c.child];
-        if (group.empty()) {
-            child_order.push_back(c.child);
+        const auto [it, inserted] = index.emplace(c.child, grouped.children.size());
+        if (inserted) {
+            grouped.children.push_back(c.child);
+            grouped.groups.emplace_back();
         }
-        group.push_back(&c);
+        grouped.groups[it->second].push_back(&c);
     }
 
-    // Process children in stable order
-    for (const Odu* child : child_order) {
-        const auto& group = by_child[child];
+    return grouped;
+}
 
-        double best_cost = std::numeric_limits<double>::infinity();
-        std::optional<std::size_t> best_offset;
+} // namespace detail
 
-        // Evaluate all candidate placements for this child
-        for (const Candidate* cand : group) {
-            const auto offsets = feasible_offsets(parent_level, current, *child);
+std::vector<GroomedChild>
+admit_candidates(
+    OduLevel parent_level,
+    std::vector<GroomedChild> current,
+    const std::vector<Candidate>& candidates
+) {
+    return admit_candidates(parent_level, std::move(current), candidates, MinFragmentationPolicy{});
+}
 
-            for (std::size_t offset : offsets) {
-                if (offset != cand->offset) continue;
+std::vector<std::vector<GroomedChild>> admit_candidates_batch(
+    const std::vector<AdmissionJob>& jobs,
+    std::size_t threads
+) {
+    std::vector<std::vector<GroomedChild>> results(jobs.size());
 
-                std::vector<GroomedChild> trial = current;
-                // Include previously selected children in to_add to evaluate fragmentation correctly
-                trial.insert(trial.end(), to_add.begin(), to_add.end());
-                trial.emplace_back(child, offset);
+    // Parents share nothing; each task writes only its own result slot
+    parallel_for(jobs.size(), threads, [&](std::size_t i) {
+        const AdmissionJob& job = jobs[i];
+        results[i] = admit_candidates(job.parent_level, job.current, job.candidates);
+    });
 
-                double cost = fragmentation_cost(analyze_fragmentation(trial));
+    return results;
+}
 
-                // preserves greedy + stable tie-breaking
-                if (
-                    cost < best_cost ||
-                    (cost == best_cost && (!best_offset.has_value() || offset < *best_offset))
-                ) {
-                    best_cost = cost;
-                    best_offset = offset;
-                }
-            }
-        }
+std::vector<std::vector<GroomedChild>> admit_candidates_batch(
+    const std::vector<AdmissionJob>& jobs,
+    const CostPolicy& policy,
+    std::size_t threads
+) {
+    std::vector<std::vector<GroomedChild>> results(jobs.size());
 
-        // Admit once per child into to_add (do not modify current yet)
-        if (best_offset.has_value()) {
-            to_add.emplace_back(child, *best_offset);
-        }
-    }
+    parallel_for(jobs.size(), threads, [&](std::size_t i) {
+        const AdmissionJob& job = jobs[i];
+        results[i] = admit_candidates(job.parent_level, job.current, job.candidates, policy);
+    });
 
-    // Append all admitted children at the end to preserve input order
-    current.insert(current.end(), to_add.begin(), to_add.end());
-    return current;
+    return results;
 }
 
 } // namespace otn
@@ -0,0 +1,322 @@
+#include "otn/container_tree.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace otn {
+
+namespace {
+
+constexpr std::uint8_t bit(std::size_t level) {
+    return static_cast<std::uint8_t>(1u << level);
+}
+
+std::size_t level_value(OduLevel level) {
+    return static_cast<std::size_t>(level);
+}
+
+OduLevel level_below(OduLevel level) {
+    return static_cast<OduLevel>(static_cast<std::uint8_t>(level) - 1);
+}
+
+} // anonymous namespace
+
+ContainerTree::ContainerTree(ContainerTreeConfig config)
+    : config_(config)
+{}
+
+// ---------------- BUILDING ----------------
+
+ContainerId ContainerTree::new_node(OduLevel level, ContainerId parent, std::size_t offset) {
+    Node node{level, parent, static_cast<std::uint16_t>(offset), true, 0, {}, {},
+              AdmissionEngine(level, {}, cost_policy_picks(config_.policy))};
+    node.host_mask = own_mask(node);
+
+    ContainerId id;
+    if (!free_nodes_.empty()) {
+        id = free_nodes_.back();
+        free_nodes_.pop_back();
+        nodes_[id] = std::move(node);
+    } else {
+        id = static_cast<ContainerId>(nodes_.size());
+        nodes_.push_back(std::move(node));
+    }
+    return id;
+}
+
+DemandId ContainerTree::new_demand(ContainerId container, std::size_t offset, OduLevel level) {
+    const Demand demand{container, static_cast<std::uint16_t>(offset), level, true};
+
+    if (!free_demands_.empty()) {
+        const DemandId id = free_demands_.back();
+        free_demands_.pop_back();
+        demands_[id] = demand;
+        return id;
+    }
+    demands_.push_back(demand);
+    return static_cast<DemandId>(demands_.size() - 1);
+}
+
+ContainerId ContainerTree::add_root(OduLevel level) {
+    if (tributary_slots(level) == 0) {
+        throw std::runtime_error("Unknown ODU level");
+    }
+    const ContainerId id = new_node(level, kNoContainer, 0);
+    roots_.push_back(id);
+    return id;
+}
+
+ContainerId ContainerTree::open_container(ContainerId parent, std::size_t offset) {
+    if (!is_open(parent)) {
+        throw std::runtime_error("Unknown container");
+    }
+    if (nodes_[parent].level <= OduLevel::ODU1) {
+        throw std::runtime_error("An ODU1 cannot hold containers");
+    }
+
+    const OduLevel level = level_below(nodes_[parent].level);
+    nodes_[parent].engine.commit(&prototype(level), offset);   // throws if it does not fit
+
+    const ContainerId id = new_node(level, parent, offset);
+
+    // new_node may reallocate: index afresh
+    Node& p = nodes_[parent];
+    p.children.push_back(id);
+    for (std::size_t l = 1; l < 5; ++l) {
+        if (nodes_[id].host_mask & bit(l)) ++p.hosting_children[l];
+    }
+    refresh(parent);
+    return id;
+}
+
+DemandId ContainerTree::place_at(ContainerId container, std::size_t offset) {
+    if (!is_open(container)) {
+        throw std::runtime_error("Unknown container");
+    }
+    if (nodes_[container].level <= OduLevel::ODU1) {
+        throw std::runtime_error("An ODU1 cannot hold demands");
+    }
+
+    const OduLevel level = level_below(nodes_[container].level);
+    nodes_[container].engine.commit(&prototype(level), offset);   // throws if it does not fit
+
+    const DemandId id = new_demand(container, offset, level);
+    refresh(container);
+    return id;
+}
+
+// ---------------- SUMMARIES ----------------
+
+std::uint8_t ContainerTree::own_mask(const Node& node) const {
+    const std::size_t p = level_value(node.level);
+    if (p < 2) return 0;
+
+    std::uint8_t mask = 0;
+
+    // Free room for a direct child also means room for a new intermediate,
+    // which can carry any lower level
+    if (!node.engine.feasible_mask(level_below(node.level)).none()) {
+        for (std::size_t l = 1; l < p; ++l) mask |= bit(l);
+    }
+    for (std::size_t l = 1; l + 1 < p; ++l) {
+        if (node.hosting_children[l] > 0) mask |= bit(l);
+    }
+    return mask;
+}
+
+void ContainerTree::refresh(ContainerId id) {
+    while (id != kNoContainer) {
+        Node& node = nodes_[id];
+        const std::uint8_t old_mask = node.host_mask;
+        const std::uint8_t new_mask = own_mask(node);
+        if (new_mask == old_mask) return;
+
+        node.host_mask = new_mask;
+        if (node.parent == kNoContainer) return;
+
+        Node& parent = nodes_[node.parent];
+        const std::uint8_t changed = old_mask ^ new_mask;
+        for (std::size_t l = 1; l < 5; ++l) {
+            if (!(changed & bit(l))) continue;
+            if (new_mask & bit(l)) ++parent.hosting_children[l];
+            else --parent.hosting_children[l];
+        }
+        id = node.parent;
+    }
+}
+
+void ContainerTree::close_if_empty(ContainerId id) {
+    if (!config_.close_empty_containers) return;
+
+    while (nodes_[id].parent != kNoContainer && nodes_[id].engine.occupancy().none()) {
+        Node& node = nodes_[id];
+        Node& parent = nodes_[node.parent];
+
+        for (std::size_t l = 1; l < 5; ++l) {
+            if (node.host_mask & bit(l)) --parent.hosting_children[l];
+        }
+        // Order preserved: sibling order breaks ties in the search
+        parent.children.erase(std::find(parent.children.begin(), parent.children.end(), id));
+        parent.engine.release(node.offset, tributary_slots(node.level));
+
+        const ContainerId up = node.parent;
+        node.open = false;
+        node.children.clear();
+        free_nodes_.push_back(id);
+
+        refresh(up);
+        id = up;
+    }
+}
+
+bool ContainerTree::verify_summaries() const {
+    bool ok = true;
+
+    // Post-order from each root: a child's expected mask is final before its parent's
+    std::vector<std::uint8_t> expected(nodes_.size(), 0);
+    std::vector<std::pair<ContainerId, bool>> stack;
+    for (ContainerId root : roots_) stack.push_back({root, false});
+
+    while (!stack.empty()) {
+        const auto [id, expanded] = stack.back();
+        stack.pop_back();
+        const Node& node = nodes_[id];
+
+        if (!expanded) {
+            stack.push_back({id, true});
+            for (ContainerId c : node.children) stack.push_back({c, false});
+            continue;
+        }
+
+        const std::size_t p = level_value(node.level);
+        std::uint8_t mask = 0;
+        if (p >= 2 && !node.engine.feasible_mask(level_below(node.level)).none()) {
+            for (std::size_t l = 1; l < p; ++l) mask |= bit(l);
+        }
+
+        std::array<std::uint32_t, 5> hosting{};
+        for (ContainerId c : node.children) {
+            for (std::size_t l = 1; l < 5; ++l) {
+                if (expected[c] & bit(l)) ++hosting[l];
+            }
+            mask |= static_cast<std::uint8_t>(expected[c] & (bit(p > 1 ? p - 1 : 0) - 1));
+        }
+
+        expected[id] = mask;
+        ok = ok && mask == node.host_mask && hosting == node.hosting_children;
+    }
+    return ok;
+}
+
+// ---------------- SEARCH ----------------
+
+template <typename Policy>
+void ContainerTree::search(
+    ContainerId id,
+    OduLevel demand,
+    const Policy& policy,
+    HierarchicalPlacement& best
+) const {
+    ++best.visited;
+    const Node& node = nodes_[id];
+    const std::size_t p = level_value(node.level);
+    const std::size_t d = level_value(demand);
+
+    const auto consider = [&](std::size_t opened, const AdmissionResult& r) {
+        if (!r.admitted) return;
+        if (best.admitted &&
+            (opened > best.opened || (opened == best.opened && !(r.cost < best.cost)))) {
+            return;
+        }
+        best.admitted = true;
+        best.anchor = id;
+        best.anchor_offset = r.chosen_offset;
+        best.opened = opened;
+        best.cost = r.cost;
+    };
+
+    if (p == d + 1) {
+        consider(0, node.engine.best_placement(prototype(demand), policy));
+        return;
+    }
+
+    // Existing intermediates first; full subtrees are skipped unvisited
+    for (ContainerId c : node.children) {
+        if (can_host(c, demand)) search(c, demand, policy, best);
+    }
+
+    // Then a new chain of p - 1 - d intermediates opened here
+    const std::size_t opened = p - 1 - d;
+    if (!best.admitted || opened <= best.opened) {
+        consider(opened, node.engine.best_placement(prototype(level_below(node.level)), policy));
+    }
+}
+
+template <typename Policy>
+HierarchicalPlacement ContainerTree::find_with(OduLevel level, const Policy& policy) const {
+    HierarchicalPlacement best;
+    for (ContainerId root : roots_) {
+        if (can_host(root, level)) search(root, level, policy, best);
+    }
+    return best;
+}
+
+template <typename Policy>
+HierarchicalPlacement ContainerTree::place_with(OduLevel level, const Policy& policy) {
+    HierarchicalPlacement result = find_with(level, policy);
+    if (!result.admitted) return result;
+
+    ContainerId id = result.anchor;
+    std::size_t offset = result.anchor_offset;
+
+    if (result.opened > 0) {
+        id = open_container(id, offset);
+
+        // Each new container is empty, so the policy only picks the offset
+        while (level_value(nodes_[id].level) > level_value(level) + 1) {
+            const OduLevel below = level_below(nodes_[id].level);
+            id = open_container(id, nodes_[id].engine.best_placement(prototype(below), policy).chosen_offset);
+        }
+        offset = nodes_[id].engine.best_placement(prototype(level), policy).chosen_offset;
+    }
+
+    result.demand = place_at(id, offset);
+    result.container = id;
+    result.offset = offset;
+    return result;
+}
+
+HierarchicalPlacement ContainerTree::find(OduLevel level) const {
+    if (tributary_slots(level) == 0) {
+        throw std::runtime_error("Unknown ODU level");
+    }
+    return dispatch_cost_policy(config_.policy, config_.cost_weights, [&](const auto& policy) {
+        return find_with(level, policy);
+    });
+}
+
+HierarchicalPlacement ContainerTree::place(OduLevel level) {
+    if (tributary_slots(level) == 0) {
+        throw std::runtime_error("Unknown ODU level");
+    }
+    return dispatch_cost_policy(config_.policy, config_.cost_weights, [&](const auto& policy) {
+        return place_with(level, policy);
+    });
+}
+
+void ContainerTree::release(DemandId id) {
+    if (!is_placed(id)) {
+        throw std::runtime_error("Releasing unknown demand");
+    }
+
+    Demand& demand = demands_[id];
+    demand.placed = false;
+    free_demands_.push_back(id);
+
+    const ContainerId container = demand.container;
+    nodes_[container].engine.release(demand.offset, tributary_slots(demand.level));
+    refresh(container);
+    close_if_empty(container);
+}
+
+} // namespace otn
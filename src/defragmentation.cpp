@@ -0,0 +1,218 @@
+#include "otn/defragmentation.hpp"
+#include "otn/grooming_planner.hpp"
+#include "otn/slot_map.hpp"
+
+#include <unordered_map>
+
+namespace otn {
+
+namespace {
+
+constexpr std::size_t kUnreachable = SlotMap::npos;
+
+// Occupancy plus child start bits identify a layout up to swapping
+// equal-width children, which is all the search cares about
+struct LayoutKey {
+    SlotMap::Words occupied;
+    SlotMap::Words starts;
+
+    bool operator==(const LayoutKey& other) const {
+        return occupied == other.occupied && starts == other.starts;
+    }
+};
+
+struct LayoutHash {
+    std::size_t operator()(const LayoutKey& key) const {
+        std::size_t h = 0;
+        for (std::uint64_t w : key.occupied) {
+            h ^= std::hash<std::uint64_t>{}(w) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+        }
+        for (std::uint64_t w : key.starts) {
+            h ^= std::hash<std::uint64_t>{}(w) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+        }
+        return h;
+    }
+};
+
+class DefragSearch {
+public:
+    DefragSearch(
+        OduLevel parent_level,
+        const std::vector<GroomedChild>& grooming,
+        const DefragTarget& target,
+        const DefragBudget& budget
+    )
+        : children_(grooming),
+          target_(target),
+          budget_(budget),
+          occupied_(occupied_slot_map(parent_level, grooming)),
+          starts_(occupied_.capacity())
+    {
+        offsets_.reserve(grooming.size());
+        for (const auto& g : grooming) {
+            offsets_.push_back(g.slot_offset);
+            if (g.slot_width > 0) starts_.set_range(g.slot_offset, 1);
+        }
+    }
+
+    /*
+     *  - Moves still needed, at least
+     *  - Free run: every child overlapping the cheapest window must move once
+     *  - Cost: one move if the threshold is not met yet
+     */
+    std::size_t lower_bound() const {
+        if (target_.kind == DefragTarget::Kind::COST_BELOW) {
+            return target_met() ? 0 : 1;
+        }
+
+        const std::size_t width = target_.run_width;
+        const std::size_t capacity = occupied_.capacity();
+        if (width == 0) return 0;
+
+        // Moves never change the free slot count
+        if (width > capacity || occupied_.free_count() < width) {
+            return kUnreachable;
+        }
+
+        std::size_t best = kUnreachable;
+        for (std::size_t s = 0; s + width <= capacity; ++s) {
+            std::size_t blockers = starts_.count_range(s, width);
+            // A child straddling the window's left edge
+            if (occupied_.test(s) && !starts_.test(s)) ++blockers;
+            if (blockers < best) best = blockers;
+        }
+        return best;
+    }
+
+    bool run(std::size_t limit) {
+        best_depth_.clear();
+        path_.clear();
+        return dfs(0, limit);
+    }
+
+    bool exhausted() const { return exhausted_; }
+    std::size_t nodes() const { return nodes_; }
+    const std::vector<DefragMove>& path() const { return path_; }
+    const std::vector<std::size_t>& offsets() const { return offsets_; }
+
+private:
+    bool target_met() const {
+        if (target_.kind == DefragTarget::Kind::FREE_CONTIGUOUS_RUN) {
+            return target_.run_width == 0 ||
+                   occupied_.find_first_fit(target_.run_width) != SlotMap::npos;
+        }
+        return fragmentation_cost(
+            analyze_fragmentation(occupied_), target_.weights
+        ) < target_.max_cost;
+    }
+
+    void move(std::size_t i, std::size_t to) {
+        const std::size_t width = children_[i].slot_width;
+        const std::size_t from = offsets_[i];
+
+        occupied_.clear_range(from, width);
+        occupied_.set_range(to, width);
+        starts_.clear_range(from, 1);
+        starts_.set_range(to, 1);
+        offsets_[i] = to;
+    }
+
+    bool dfs(std::size_t depth, std::size_t limit) {
+        if (nodes_ >= budget_.max_nodes) {
+            exhausted_ = true;
+            return false;
+        }
+        ++nodes_;
+
+        if (target_met()) return true;
+
+        const std::size_t h = lower_bound();
+        if (h == kUnreachable || depth + h > limit) return false;
+
+        // Skip layouts this iteration already reached in as few moves
+        auto seen = best_depth_.emplace(
+            LayoutKey{occupied_.words(), starts_.words()}, depth
+        );
+        if (!seen.second) {
+            if (seen.first->second <= depth) return false;
+            seen.first->second = depth;
+        }
+
+        for (std::size_t i = 0; i < children_.size(); ++i) {
+            const std::size_t width = children_[i].slot_width;
+            if (width == 0) continue;
+
+            // Computed with the mover still in place: make-before-break
+            const SlotMap fits = occupied_.fit_mask(width);
+            const std::size_t from = offsets_[i];
+
+            for (std::size_t to = fits.find_next_set(0);
+                 to != SlotMap::npos;
+                 to = fits.find_next_set(to + 1)) {
+                move(i, to);
+                path_.push_back({children_[i].child, width, from, to});
+
+                if (dfs(depth + 1, limit)) return true;
+
+                path_.pop_back();
+                move(i, from);
+
+                if (exhausted_) return false;
+            }
+        }
+
+        return false;
+    }
+
+    const std::vector<GroomedChild>& children_;
+    const DefragTarget& target_;
+    const DefragBudget& budget_;
+
+    SlotMap occupied_;
+    SlotMap starts_;
+    std::vector<std::size_t> offsets_;
+    std::vector<DefragMove> path_;
+
+    std::unordered_map<LayoutKey, std::size_t, LayoutHash> best_depth_;
+    std::size_t nodes_ = 0;
+    bool exhausted_ = false;
+};
+
+} // anonymous namespace
+
+DefragPlan plan_defragmentation(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    const DefragTarget& target,
+    const DefragBudget& budget
+) {
+    DefragSearch search(parent_level, grooming, target, budget);
+
+    DefragPlan plan{{}, grooming, false, false, 0};
+
+    const std::size_t first_limit = search.lower_bound();
+    if (first_limit == kUnreachable) {
+        // No sequence of moves can create enough free slots
+        return plan;
+    }
+
+    // Iterative deepening: the first limit that succeeds is the minimum,
+    // as long as no earlier iteration was cut short by the budget
+    for (std::size_t limit = first_limit; limit <= budget.max_moves; ++limit) {
+        if (search.run(limit)) {
+            plan.moves = search.path();
+            for (std::size_t i = 0; i < plan.result.size(); ++i) {
+                plan.result[i].slot_offset = search.offsets()[i];
+            }
+            plan.target_met = true;
+            plan.proven_minimal = true;
+            break;
+        }
+        if (search.exhausted()) break;
+    }
+
+    plan.nodes_explored = search.nodes();
+    return plan;
+}
+
+} // namespace otn
@@ -1,14 +1,23 @@
 #include "otn/fragmentation.hpp"
+#include "otn/instrumentation.hpp"
 #include "otn/odu.hpp"
+#include "otn/slot_map.hpp"
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <stdexcept>
+#include <unordered_set>
 
 namespace otn {
 
 FragmentationMetrics analyze_fragmentation(
     const std::vector<GroomedChild>& grooming
 ) {
+    OTN_COUNT(ANALYZE_FRAGMENTATION);
+    OTN_TIME_SCOPE(ANALYZE_FRAGMENTATION);
+
     if (grooming.empty()) {
         return {0, 0, 0, 0, 0.0};
     }
@@ -67,12 +76,291 @@ FragmentationMetrics analyze_fragmentation(
     };
 }
 
+FragmentationMetrics analyze_fragmentation(const SlotMap& occupancy) {
+    OTN_COUNT(ANALYZE_FRAGMENTATION);
+    OTN_TIME_SCOPE(ANALYZE_FRAGMENTATION);
 
-std::vector<GroomedChild> repack_grooming_size_aware(
-    OduLevel parent_level,
+    const size_t first_slot = occupancy.find_next_set(0);
+    if (first_slot == SlotMap::npos) {
+        return {0, 0, 0, 0, 0.0};
+    }
+
+    const SlotMap free_slots = occupancy.complement();
+
+    size_t gap_count = 0;
+    size_t total_gap_slots = 0;
+    size_t max_gap = 0;
+    size_t end_slot = occupancy.capacity();
+
+    // Walk alternating occupied / free runs
+    size_t pos = first_slot;
+    for (;;) {
+        const size_t gap_start = free_slots.find_next_set(pos);
+        if (gap_start == SlotMap::npos) break;
+
+        const size_t next_used = occupancy.find_next_set(gap_start);
+        if (next_used == SlotMap::npos) {
+            end_slot = gap_start; // trailing free run is not a gap
+            break;
+        }
+
+        const size_t gap = next_used - gap_start;
+        ++gap_count;
+        total_gap_slots += gap;
+        max_gap = std::max(max_gap, gap);
+        pos = next_used;
+    }
+
+    const size_t span_slots = end_slot - first_slot;
+    const size_t occupied_slots = span_slots - total_gap_slots;
+
+    return {
+        gap_count,
+        total_gap_slots,
+        max_gap,
+        span_slots,
+        static_cast<double>(occupied_slots) / static_cast<double>(span_slots)
+    };
+}
+
+// ---------------- INCREMENTAL STATE ----------------
+
+FragmentationState::FragmentationState(
     const std::vector<GroomedChild>& grooming
 ) {
-    if (grooming.empty()) return {};
+    for (const auto& g : grooming) {
+        insert(g.slot_offset, g.slot_width);
+    }
+}
+
+FragmentationState::Placement FragmentationState::check_free(
+    std::size_t offset,
+    std::size_t width
+) const {
+    if (width == 0) {
+        throw std::runtime_error("Zero-width placement in fragmentation state");
+    }
+
+    // First placement starting at or after offset
+    auto next = placed_.lower_bound(offset);
+
+    if (next != placed_.end() && next->first < offset + width) {
+        throw std::runtime_error("Overlapping placement in fragmentation state");
+    }
+    if (next != placed_.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second > offset) {
+            throw std::runtime_error("Overlapping placement in fragmentation state");
+        }
+    }
+
+    return next;
+}
+
+void FragmentationState::insert(std::size_t offset, std::size_t width) {
+    const auto next = check_free(offset, width);
+    const std::size_t end = offset + width;
+
+    const bool has_next = next != placed_.end();
+    const bool has_prev = next != placed_.begin();
+    const std::size_t prev_end =
+        has_prev ? std::prev(next)->first + std::prev(next)->second : 0;
+
+    // The new child splits the gap between its neighbours (if any)
+    if (has_prev && has_next) {
+        const std::size_t old_gap = next->first - prev_end;
+        if (old_gap > 0) {
+            gaps_.erase(gaps_.find(old_gap));
+            total_gap_slots_ -= old_gap;
+        }
+    }
+    if (has_prev && offset > prev_end) {
+        gaps_.insert(offset - prev_end);
+        total_gap_slots_ += offset - prev_end;
+    }
+    if (has_next && next->first > end) {
+        gaps_.insert(next->first - end);
+        total_gap_slots_ += next->first - end;
+    }
+
+    placed_.emplace_hint(next, offset, width);
+}
+
+void FragmentationState::remove(std::size_t offset, std::size_t width) {
+    auto it = placed_.find(offset);
+    if (it == placed_.end() || it->second != width) {
+        throw std::runtime_error("Removing unknown placement from fragmentation state");
+    }
+
+    const std::size_t end = offset + width;
+    const auto next = std::next(it);
+
+    const bool has_next = next != placed_.end();
+    const bool has_prev = it != placed_.begin();
+    const std::size_t prev_end =
+        has_prev ? std::prev(it)->first + std::prev(it)->second : 0;
+
+    if (has_prev && offset > prev_end) {
+        gaps_.erase(gaps_.find(offset - prev_end));
+        total_gap_slots_ -= offset - prev_end;
+    }
+    if (has_next && next->first > end) {
+        gaps_.erase(gaps_.find(next->first - end));
+        total_gap_slots_ -= next->first - end;
+    }
+    // Neighbours now face each other across the freed range
+    if (has_prev && has_next) {
+        gaps_.insert(next->first - prev_end);
+        total_gap_slots_ += next->first - prev_end;
+    }
+
+    placed_.erase(it);
+}
+
+void FragmentationState::clear() {
+    placed_.clear();
+    gaps_.clear();
+    total_gap_slots_ = 0;
+}
+
+FragmentationMetrics FragmentationState::make_metrics(
+    std::size_t first_slot,
+    std::size_t end_slot,
+    std::size_t gap_count,
+    std::size_t total_gap_slots,
+    std::size_t max_gap
+) const {
+    const std::size_t span_slots = end_slot - first_slot;
+    const std::size_t occupied = span_slots - total_gap_slots;
+
+    const double utilization =
+        span_slots == 0
+            ? 0.0
+            : static_cast<double>(occupied) /
+              static_cast<double>(span_slots);
+
+    return {
+        gap_count,
+        total_gap_slots,
+        max_gap,
+        span_slots,
+        utilization
+    };
+}
+
+FragmentationMetrics FragmentationState::metrics() const {
+    if (placed_.empty()) {
+        return {0, 0, 0, 0, 0.0};
+    }
+
+    const auto last = std::prev(placed_.end());
+    return make_metrics(
+        placed_.begin()->first,
+        last->first + last->second,
+        gaps_.size(),
+        total_gap_slots_,
+        gaps_.empty() ? 0 : *gaps_.rbegin()
+    );
+}
+
+FragmentationMetrics FragmentationState::what_if(
+    std::size_t offset,
+    std::size_t width
+) const {
+    const auto next = check_free(offset, width);
+    const std::size_t end = offset + width;
+
+    if (placed_.empty()) {
+        return make_metrics(offset, end, 0, 0, 0);
+    }
+
+    const bool has_next = next != placed_.end();
+    const bool has_prev = next != placed_.begin();
+    const std::size_t prev_end =
+        has_prev ? std::prev(next)->first + std::prev(next)->second : 0;
+
+    std::size_t gap_count = gaps_.size();
+    std::size_t total_gap = total_gap_slots_;
+
+    // Largest surviving gap, skipping one instance of the split gap
+    auto largest = gaps_.rbegin();
+    if (has_prev && has_next) {
+        const std::size_t old_gap = next->first - prev_end;
+        if (old_gap > 0) {
+            --gap_count;
+            total_gap -= old_gap;
+            if (largest != gaps_.rend() && *largest == old_gap) ++largest;
+        }
+    }
+    std::size_t max_gap = largest == gaps_.rend() ? 0 : *largest;
+
+    if (has_prev && offset > prev_end) {
+        ++gap_count;
+        total_gap += offset - prev_end;
+        max_gap = std::max(max_gap, offset - prev_end);
+    }
+    if (has_next && next->first > end) {
+        ++gap_count;
+        total_gap += next->first - end;
+        max_gap = std::max(max_gap, next->first - end);
+    }
+
+    const auto last = std::prev(placed_.end());
+    return make_metrics(
+        std::min(offset, placed_.begin()->first),
+        std::max(end, last->first + last->second),
+        gap_count,
+        total_gap,
+        max_gap
+    );
+}
+
+namespace {
+
+// Greedy first-fit of already-ordered children into an empty parent
+GroomStatus first_fit_repack(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& ordered,
+    std::vector<GroomedChild>& out
+) {
+    SlotMap slot_map(tributary_slots(parent_level));
+    out.reserve(ordered.size());
+
+    for (const auto& g : ordered) {
+        const size_t start = slot_map.find_first_fit(g.slot_width);
+
+        if (start == SlotMap::npos) {
+            OTN_COUNT(REPACK_BLOCKED);
+            out.clear();
+            return GroomStatus::INSUFFICIENT_SLOTS;
+        }
+
+        slot_map.set_range(start, g.slot_width);
+        out.emplace_back(g.child, g.slot_width, start);
+    }
+
+    return GroomStatus::OK;
+}
+
+std::vector<GroomedChild> repack_or_throw(GroomStatus status, std::vector<GroomedChild>& out) {
+    if (status != GroomStatus::OK) {
+        throw std::runtime_error("Cannot repack: not enough contiguous slots");
+    }
+    return std::move(out);
+}
+
+} // anonymous namespace
+
+GroomStatus try_repack_grooming_size_aware(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    std::vector<GroomedChild>& out
+) {
+    OTN_COUNT(REPACK);
+    OTN_TIME_SCOPE(REPACK);
+
+    out.clear();
+    if (grooming.empty()) return GroomStatus::OK;
 
     std::vector<GroomedChild> sorted = grooming;
 
@@ -87,36 +375,25 @@ std::vector<GroomedChild> repack_grooming_size_aware(
         }
     );
 
-    size_t max_slots = tributary_slots(parent_level);
-    std::vector<bool> slot_map(max_slots, false);
-    std::vector<GroomedChild> repacked;
-
-    for (const auto& g : sorted) {
-        bool placed = false;
-        for (size_t start = 0; start + g.slot_width <= max_slots; ++start) {
-            bool free = true;
-            for (size_t i = 0; i < g.slot_width; ++i) {
-                if (slot_map[start + i]) {
-                    free = false;
-                    break;
-                }
-            }
-            if (free) {
-                for (size_t i = 0; i < g.slot_width; ++i)
-                    slot_map[start + i] = true;
-
-                repacked.emplace_back(g.child, g.slot_width, start);
-                placed = true;
-                break;
-            }
-        }
+    return first_fit_repack(parent_level, sorted, out);
+}
 
-        if (!placed) {
-            throw std::runtime_error("Cannot repack: not enough contiguous slots");
-        }
-    }
+std::vector<GroomedChild> repack_grooming_size_aware(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming
+) {
+    std::vector<GroomedChild> repacked;
+    return repack_or_throw(
+        try_repack_grooming_size_aware(parent_level, grooming, repacked), repacked
+    );
+}
 
-    return repacked;
+GroomStatus try_repack_grooming(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    std::vector<GroomedChild>& out
+) {
+    return try_repack_grooming_size_aware(parent_level, grooming, out);
 }
 
 std::vector<GroomedChild> repack_grooming(
@@ -126,13 +403,16 @@ std::vector<GroomedChild> repack_grooming(
     return repack_grooming_size_aware(parent_level, grooming);
 }
 
-std::vector<GroomedChild> repack_grooming_deterministic(
+GroomStatus try_repack_grooming_deterministic(
     OduLevel parent_level,
-    const std::vector<GroomedChild>& grooming
+    const std::vector<GroomedChild>& grooming,
+    std::vector<GroomedChild>& out
 ) {
-    if (grooming.empty()) return {};
+    OTN_COUNT(REPACK);
+    OTN_TIME_SCOPE(REPACK);
 
-    size_t max_slots = tributary_slots(parent_level);
+    out.clear();
+    if (grooming.empty()) return GroomStatus::OK;
 
     // Step 1: Sort children descending by slot_width, preserve original order on ties
     std::vector<GroomedChild> sorted = grooming;
@@ -143,34 +423,220 @@ std::vector<GroomedChild> repack_grooming_deterministic(
     );
 
     // Step 2: Greedy placement: place each child in first available contiguous slot
-    std::vector<bool> slot_map(max_slots, false); // marks used slots
+    return first_fit_repack(parent_level, sorted, out);
+}
+
+std::vector<GroomedChild> repack_grooming_deterministic(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming
+) {
     std::vector<GroomedChild> repacked;
+    return repack_or_throw(
+        try_repack_grooming_deterministic(parent_level, grooming, repacked), repacked
+    );
+}
 
-    for (const auto& g : sorted) {
-        // Find first contiguous space of size g.slot_width
-        size_t start = 0;
-        bool placed = false;
-        while (start + g.slot_width <= max_slots) {
-            bool free = true;
-            for (size_t i = 0; i < g.slot_width; ++i) {
-                if (slot_map[start + i]) { free = false; break; }
-            }
-            if (free) {
-                // Place child here
-                for (size_t i = 0; i < g.slot_width; ++i) slot_map[start + i] = true;
-                repacked.push_back({g.child, g.slot_width, start});
-                placed = true;
-                break;
+// ---------------- EXACT REPACK ----------------
+
+namespace {
+
+// Subproblem identity: next child to place, symmetry floor, occupancy
+struct RepackStateKey {
+    size_t index;
+    size_t min_offset;
+    SlotMap::Words words;
+
+    bool operator==(const RepackStateKey& other) const {
+        return index == other.index &&
+               min_offset == other.min_offset &&
+               words == other.words;
+    }
+};
+
+struct RepackStateHash {
+    size_t operator()(const RepackStateKey& key) const {
+        size_t h = std::hash<size_t>{}(key.index * 131 + key.min_offset);
+        for (std::uint64_t w : key.words) {
+            h ^= std::hash<std::uint64_t>{}(w) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+        }
+        return h;
+    }
+};
+
+class ExactRepacker {
+public:
+    ExactRepacker(
+        const std::vector<GroomedChild>& sorted,
+        size_t max_slots,
+        const RepackBudget& budget
+    )
+        : sorted_(sorted),
+          budget_(budget),
+          deadline_(std::chrono::steady_clock::now() + budget.time_limit),
+          occupancy_(max_slots),
+          offsets_(sorted.size(), 0)
+    {}
+
+    void run() { search(0, 0); }
+
+    bool found() const { return !best_offsets_.empty() || sorted_.empty(); }
+    bool exhausted() const { return exhausted_; }
+    double best_cost() const { return best_cost_; }
+    size_t nodes() const { return nodes_; }
+    const std::vector<size_t>& best_offsets() const { return best_offsets_; }
+
+private:
+    bool out_of_budget() {
+        if (nodes_ >= budget_.max_nodes) return true;
+        // Clock reads are comparatively expensive; sample them
+        if ((nodes_ & 0xff) == 0 && std::chrono::steady_clock::now() >= deadline_) {
+            return true;
+        }
+        return false;
+    }
+
+    void search(size_t index, size_t min_offset) {
+        // Zero is the lowest possible cost: nothing can beat it
+        if (exhausted_ || best_cost_ <= 0.0) return;
+
+        if (out_of_budget()) {
+            exhausted_ = true;
+            return;
+        }
+        ++nodes_;
+
+        if (index == sorted_.size()) {
+            const double cost = fragmentation_cost(
+                analyze_fragmentation(occupancy_), budget_.weights
+            );
+            if (cost < best_cost_) {
+                best_cost_ = cost;
+                best_offsets_ = offsets_;
             }
-            ++start;
+            return;
         }
 
-        if (!placed) {
-            throw std::runtime_error("Cannot repack: not enough contiguous slots");
+        if (!visited_.insert({index, min_offset, occupancy_.words()}).second) {
+            return;
+        }
+
+        const size_t width = sorted_[index].slot_width;
+
+        // Equal-width children are interchangeable: keep their offsets ascending
+        const bool same_as_next =
+            index + 1 < sorted_.size() && sorted_[index + 1].slot_width == width;
+
+        const SlotMap fits = occupancy_.fit_mask(width);
+        for (size_t start = fits.find_next_set(min_offset);
+             start != SlotMap::npos;
+             start = fits.find_next_set(start + 1)) {
+            occupancy_.set_range(start, width);
+            offsets_[index] = start;
+
+            search(index + 1, same_as_next ? start + 1 : 0);
+
+            occupancy_.clear_range(start, width);
+            if (exhausted_ || best_cost_ <= 0.0) return;
         }
     }
 
-    return repacked;
+    const std::vector<GroomedChild>& sorted_;
+    const RepackBudget& budget_;
+    const std::chrono::steady_clock::time_point deadline_;
+
+    SlotMap occupancy_;
+    std::vector<size_t> offsets_;
+
+    std::vector<size_t> best_offsets_;
+    double best_cost_ = std::numeric_limits<double>::infinity();
+
+    std::unordered_set<RepackStateKey, RepackStateHash> visited_;
+    size_t nodes_ = 0;
+    bool exhausted_ = false;
+};
+
+} // anonymous namespace
+
+GroomStatus try_repack_grooming_optimal(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    RepackReport& out,
+    const RepackBudget& budget
+) {
+    OTN_COUNT(REPACK_OPTIMAL);
+    OTN_TIME_SCOPE(REPACK_OPTIMAL);
+
+    if (grooming.empty()) {
+        out = {{}, 0.0, true, false, 0};
+        return GroomStatus::OK;
+    }
+
+    // Same ordering as the greedy size-aware repack, which also fixes
+    // the branching order (large children first)
+    std::vector<GroomedChild> sorted = grooming;
+    std::stable_sort(sorted.begin(), sorted.end(),
+        [](const GroomedChild& a, const GroomedChild& b) {
+            if (a.slot_width != b.slot_width)
+                return a.slot_width > b.slot_width;
+            return a.child->payload_size() > b.child->payload_size();
+        }
+    );
+
+    ExactRepacker search(sorted, tributary_slots(parent_level), budget);
+    search.run();
+    OTN_COUNT_N(REPACK_OPTIMAL_NODES, search.nodes());
+
+    RepackReport& report = out;
+    report = {{}, 0.0, false, false, search.nodes()};
+
+    if (search.found()) {
+        report.grooming.reserve(sorted.size());
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            report.grooming.emplace_back(
+                sorted[i].child, sorted[i].slot_width, search.best_offsets()[i]
+            );
+        }
+        report.cost = search.best_cost();
+    }
+
+    if (!search.exhausted()) {
+        if (!search.found()) {
+            return GroomStatus::INSUFFICIENT_SLOTS;
+        }
+        report.proven_optimal = true;
+        return GroomStatus::OK;
+    }
+
+    // Budget exhausted: fall back to greedy if it beats the incumbent
+    std::vector<GroomedChild> greedy;
+    if (try_repack_grooming_size_aware(parent_level, grooming, greedy) != GroomStatus::OK) {
+        return search.found() ? GroomStatus::OK : GroomStatus::INSUFFICIENT_SLOTS;
+    }
+
+    const double greedy_cost = fragmentation_cost(
+        analyze_fragmentation(greedy), budget.weights
+    );
+    if (!search.found() || greedy_cost < report.cost) {
+        report.grooming = std::move(greedy);
+        report.cost = greedy_cost;
+        report.used_fallback = true;
+    }
+    // The zero-cost floor still proves optimality
+    report.proven_optimal = report.cost <= 0.0;
+
+    return GroomStatus::OK;
+}
+
+RepackReport repack_grooming_optimal(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    const RepackBudget& budget
+) {
+    RepackReport report;
+    if (try_repack_grooming_optimal(parent_level, grooming, report, budget) != GroomStatus::OK) {
+        throw std::runtime_error("Cannot repack: not enough contiguous slots");
+    }
+    return report;
 }
 
 double fragmentation_cost(
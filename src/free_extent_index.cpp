@@ -0,0 +1,242 @@
+#include "otn/free_extent_index.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace otn {
+
+FreeExtentIndex::FreeExtentIndex(std::size_t capacity)
+    : capacity_(capacity),
+      free_slots_(0),
+      leaves_(1)
+{
+    while (leaves_ < capacity_) leaves_ *= 2;
+    tree_.assign(2 * leaves_, 0);
+
+    if (capacity_ > 0) {
+        insert_extent(0, capacity_);
+        free_slots_ = capacity_;
+    }
+}
+
+FreeExtentIndex FreeExtentIndex::from_occupancy(const SlotMap& occupancy) {
+    FreeExtentIndex index(occupancy.capacity());
+
+    // Allocate each occupied run in one step
+    std::size_t pos = occupancy.find_next_set(0);
+    while (pos != SlotMap::npos) {
+        std::size_t end = pos + 1;
+        while (end < occupancy.capacity() && occupancy.test(end)) ++end;
+        index.allocate(pos, end - pos);
+        pos = occupancy.find_next_set(end);
+    }
+    return index;
+}
+
+// ---------------- BOOKKEEPING ----------------
+
+void FreeExtentIndex::set_leaf(std::size_t offset, std::size_t length) {
+    std::size_t node = leaves_ + offset;
+    tree_[node] = static_cast<std::uint32_t>(length);
+
+    for (node /= 2; node >= 1; node /= 2) {
+        tree_[node] = std::max(tree_[2 * node], tree_[2 * node + 1]);
+    }
+}
+
+void FreeExtentIndex::insert_extent(std::size_t offset, std::size_t length) {
+    by_offset_.emplace(offset, length);
+    by_length_.emplace(length, offset);
+    set_leaf(offset, length);
+}
+
+void FreeExtentIndex::erase_extent(std::size_t offset, std::size_t length) {
+    by_offset_.erase(offset);
+    by_length_.erase({length, offset});
+    set_leaf(offset, 0);
+}
+
+void FreeExtentIndex::replace_extent(
+    std::size_t offset, std::size_t length,
+    std::size_t new_offset, std::size_t new_length
+) {
+    // Re-keys the existing nodes instead of freeing and allocating new ones
+    auto by_offset = by_offset_.extract(offset);
+    by_offset.key() = new_offset;
+    by_offset.mapped() = new_length;
+    by_offset_.insert(std::move(by_offset));
+
+    auto by_length = by_length_.extract({length, offset});
+    by_length.value() = {new_length, new_offset};
+    by_length_.insert(std::move(by_length));
+
+    if (new_offset != offset) set_leaf(offset, 0);
+    set_leaf(new_offset, new_length);
+}
+
+bool FreeExtentIndex::range_free(std::size_t offset, std::size_t width) const {
+    if (offset > capacity_ || width > capacity_ - offset) return false;
+    if (width == 0) return true;
+
+    const FreeExtent run = extent_at(offset);
+    return run.offset != npos && offset + width <= run.offset + run.length;
+}
+
+FreeExtent FreeExtentIndex::extent_at(std::size_t slot) const {
+    auto it = by_offset_.upper_bound(slot);
+    if (it == by_offset_.begin()) return {npos, 0};
+
+    --it;
+    if (slot >= it->first + it->second) return {npos, 0};
+    return {it->first, it->second};
+}
+
+void FreeExtentIndex::allocate(std::size_t offset, std::size_t width) {
+    if (width == 0 || !range_free(offset, width)) {
+        throw std::runtime_error("Allocating slots that are not free");
+    }
+
+    const FreeExtent run = extent_at(offset);
+    const std::size_t end = offset + width;
+    const std::size_t run_end = run.offset + run.length;
+
+    // The run splits into what is left on either side
+    if (offset > run.offset) {
+        replace_extent(run.offset, run.length, run.offset, offset - run.offset);
+        if (run_end > end) insert_extent(end, run_end - end);
+    } else if (run_end > end) {
+        replace_extent(run.offset, run.length, end, run_end - end);
+    } else {
+        erase_extent(run.offset, run.length);
+    }
+
+    free_slots_ -= width;
+}
+
+void FreeExtentIndex::release(std::size_t offset, std::size_t width) {
+    if (width == 0 || offset > capacity_ || width > capacity_ - offset) {
+        throw std::runtime_error("Releasing slots out of range");
+    }
+
+    const std::size_t end = offset + width;
+
+    const auto next = by_offset_.lower_bound(offset);
+    if (next != by_offset_.end() && next->first < end) {
+        throw std::runtime_error("Releasing slots that are already free");
+    }
+    const auto prev = next == by_offset_.begin() ? by_offset_.end() : std::prev(next);
+    if (prev != by_offset_.end() && prev->first + prev->second > offset) {
+        throw std::runtime_error("Releasing slots that are already free");
+    }
+
+    // Coalesce with the runs just before and just after
+    const bool join_prev = prev != by_offset_.end() && prev->first + prev->second == offset;
+    const bool join_next = next != by_offset_.end() && next->first == end;
+    const FreeExtent before = join_prev ? FreeExtent{prev->first, prev->second} : FreeExtent{offset, 0};
+    const FreeExtent after = join_next ? FreeExtent{next->first, next->second} : FreeExtent{end, 0};
+    const std::size_t merged = before.length + width + after.length;
+
+    if (join_prev) {
+        if (join_next) erase_extent(after.offset, after.length);
+        replace_extent(before.offset, before.length, before.offset, merged);
+    } else if (join_next) {
+        replace_extent(after.offset, after.length, offset, merged);
+    } else {
+        insert_extent(offset, width);
+    }
+    free_slots_ += width;
+}
+
+// ---------------- QUERIES ----------------
+
+std::size_t FreeExtentIndex::largest_extent() const {
+    return by_length_.empty() ? 0 : by_length_.rbegin()->first;
+}
+
+std::size_t FreeExtentIndex::first_fit(std::size_t width) const {
+    if (width == 0 || tree_[1] < width) return npos;
+
+    // Leftmost run start whose length reaches width
+    std::size_t node = 1;
+    while (node < leaves_) {
+        node = tree_[2 * node] >= width ? 2 * node : 2 * node + 1;
+    }
+    return node - leaves_;
+}
+
+std::size_t FreeExtentIndex::best_fit(std::size_t width) const {
+    if (width == 0) return npos;
+    const auto it = by_length_.lower_bound({width, 0});
+    return it == by_length_.end() ? npos : it->second;
+}
+
+std::size_t FreeExtentIndex::worst_fit(std::size_t width) const {
+    const std::size_t largest = largest_extent();
+    if (width == 0 || largest < width) return npos;
+    return by_length_.lower_bound({largest, 0})->second;
+}
+
+std::size_t FreeExtentIndex::fit(ExtentFit strategy, std::size_t width) const {
+    switch (strategy) {
+        case ExtentFit::FIRST: return first_fit(width);
+        case ExtentFit::BEST:  return best_fit(width);
+        case ExtentFit::WORST: return worst_fit(width);
+    }
+    return npos;
+}
+
+FragmentationMetrics FreeExtentIndex::metrics() const {
+    if (free_slots_ == capacity_) {
+        return {0, 0, 0, 0, 0.0};
+    }
+
+    // Leading and trailing free runs lie outside the span and are not gaps
+    std::size_t leading = 0;
+    std::size_t trailing = 0;
+    if (!by_offset_.empty()) {
+        if (by_offset_.begin()->first == 0) {
+            leading = by_offset_.begin()->second;
+        }
+        const auto last = std::prev(by_offset_.end());
+        if (last->first + last->second == capacity_) {
+            trailing = last->second;
+        }
+    }
+
+    const std::size_t gap_count =
+        by_offset_.size() - (leading > 0 ? 1 : 0) - (trailing > 0 ? 1 : 0);
+    const std::size_t total_gap_slots = free_slots_ - leading - trailing;
+    const std::size_t span_slots = capacity_ - leading - trailing;
+
+    // Longest run that is neither the leading nor the trailing one
+    std::size_t max_gap = 0;
+    for (auto it = by_length_.rbegin(); it != by_length_.rend(); ++it) {
+        const bool is_leading = leading > 0 && it->second == 0;
+        const bool is_trailing = trailing > 0 && it->second + it->first == capacity_;
+        if (!is_leading && !is_trailing) {
+            max_gap = it->first;
+            break;
+        }
+    }
+
+    return {
+        gap_count,
+        total_gap_slots,
+        max_gap,
+        span_slots,
+        static_cast<double>(span_slots - total_gap_slots) / static_cast<double>(span_slots)
+    };
+}
+
+std::vector<FreeExtent> FreeExtentIndex::extents() const {
+    std::vector<FreeExtent> out;
+    out.reserve(by_offset_.size());
+    for (const auto& [offset, length] : by_offset_) {
+        out.push_back({offset, length});
+    }
+    return out;
+}
+
+} // namespace otn
@@ -1,26 +1,31 @@
 #include "otn/grooming_planner.hpp"
+#include "otn/instrumentation.hpp"
+#include "otn/level_slot_map.hpp"
 #include "otn/odu.hpp"
 #include <stdexcept>
 #include <algorithm>
 
 namespace otn {
 
-std::vector<GroomedChild>
-plan_grooming(
+GroomStatus try_plan_grooming(
     OduLevel parent_level,
-    const std::vector<Odu>& children
+    const std::vector<Odu>& children,
+    std::vector<GroomedChild>& out
 ) {
+    OTN_COUNT(PLAN_GROOMING);
+    OTN_TIME_SCOPE(PLAN_GROOMING);
+
+    out.clear();
+
     if (children.empty()) {
-        return {};
+        return GroomStatus::OK;
     }
 
     // Validate all children have same level
     OduLevel expected = children.front().level();
     for (const auto& child : children) {
         if (child.level() != expected) {
-            throw std::runtime_error(
-                "All children must have the same ODU level"
-            );
+            return GroomStatus::MIXED_CHILD_LEVELS;
         }
     }
 
@@ -28,15 +33,12 @@ plan_grooming(
     uint8_t child_lvl  = static_cast<uint8_t>(expected);
     uint8_t parent_lvl = static_cast<uint8_t>(parent_level);
     if (parent_lvl != child_lvl + 1) {
-        throw std::runtime_error(
-            "Parent ODU level must be adjacent to children"
-        );
+        return GroomStatus::INVALID_HIERARCHY;
     }
 
     const size_t parent_slots = tributary_slots(parent_level);
 
-    std::vector<GroomedChild> result;
-    result.reserve(children.size());
+    out.reserve(children.size());
 
     size_t cursor = 0;
 
@@ -45,17 +47,42 @@ plan_grooming(
         size_t child_slots = child.slots();
 
         if (cursor + child_slots > parent_slots) {
-            throw std::runtime_error(
-                "Insufficient tributary slots for grooming"
-            );
+            OTN_COUNT(PLAN_GROOMING_BLOCKED);
+            out.clear();
+            return GroomStatus::INSUFFICIENT_SLOTS;
         }
 
-        result.emplace_back(&child, cursor);
+        out.emplace_back(&child, cursor);
 
         cursor += child_slots;
     }
 
-    return result;
+    return GroomStatus::OK;
+}
+
+std::vector<GroomedChild>
+plan_grooming(
+    OduLevel parent_level,
+    const std::vector<Odu>& children
+) {
+    std::vector<GroomedChild> result;
+
+    switch (try_plan_grooming(parent_level, children, result)) {
+        case GroomStatus::OK:
+            return result;
+        case GroomStatus::MIXED_CHILD_LEVELS:
+            throw std::runtime_error(
+                "All children must have the same ODU level"
+            );
+        case GroomStatus::INVALID_HIERARCHY:
+            throw std::runtime_error(
+                "Parent ODU level must be adjacent to children"
+            );
+        default:
+            throw std::runtime_error(
+                "Insufficient tributary slots for grooming"
+            );
+    }
 }
 
 /*
@@ -154,30 +181,64 @@ repack_grooming_size_aware(
 }
     */
 
-std::vector<bool> occupied_slots(
+GroomStatus try_occupied_slot_map(
     OduLevel parent_level,
-    const std::vector<GroomedChild>& grooming
+    const std::vector<GroomedChild>& grooming,
+    SlotMap& out
 ) {
-    const std::size_t max_slots = tributary_slots(parent_level);
-    std::vector<bool> slots(max_slots, false);
+    OTN_COUNT(OCCUPIED_SLOTS);
 
-    for (const auto& g : grooming) {
-        const std::size_t start = g.slot_offset;
-        const std::size_t width = g.slot_width;
+    // dispatch_level throws on an unknown level; report it instead
+    if (tributary_slots(parent_level) == 0) {
+        return GroomStatus::INVALID_HIERARCHY;
+    }
 
-        if (start + width > max_slots) {
-            throw std::runtime_error("GroomedChild exceeds parent slot capacity");
+    return dispatch_level(parent_level, [&](auto level) {
+        LevelSlotMap<level> occupied;
+        const GroomStatus status = fill_occupancy<level>(grooming, occupied);
+        if (status == GroomStatus::OK) {
+            out = occupied.to_slot_map();
         }
+        return status;
+    });
+}
 
-        for (std::size_t i = 0; i < width; ++i) {
-            if (slots[start + i]) {
-                throw std::runtime_error("Overlapping GroomedChild slots detected");
-            }
-            slots[start + i] = true;
-        }
+SlotMap occupied_slot_map(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming
+) {
+    SlotMap slots;
+
+    switch (try_occupied_slot_map(parent_level, grooming, slots)) {
+        case GroomStatus::OK:
+            return slots;
+        case GroomStatus::SLOT_OUT_OF_RANGE:
+            throw std::runtime_error("GroomedChild exceeds parent slot capacity");
+        case GroomStatus::INVALID_HIERARCHY:
+            throw std::runtime_error("Unknown ODU level");
+        default:
+            throw std::runtime_error("Overlapping GroomedChild slots detected");
     }
+}
+
+GroomStatus try_occupied_slots(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    std::vector<bool>& out
+) {
+    SlotMap slots;
+    const GroomStatus status = try_occupied_slot_map(parent_level, grooming, slots);
+    if (status == GroomStatus::OK) {
+        out = slots.to_vector();
+    }
+    return status;
+}
 
-    return slots;
+std::vector<bool> occupied_slots(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming
+) {
+    return occupied_slot_map(parent_level, grooming).to_vector();
 }
 
 std::vector<std::size_t> feasible_offsets(
@@ -185,35 +246,107 @@ std::vector<std::size_t> feasible_offsets(
     const std::vector<GroomedChild>& grooming,
     const Odu& candidate
 ) {
+    OTN_COUNT(FEASIBLE_OFFSETS);
+    OTN_TIME_SCOPE(FEASIBLE_OFFSETS);
+
     const std::size_t max_slots = tributary_slots(parent_level);
     const std::size_t width = tributary_slots(candidate.level());
 
     if (width > max_slots) {
+        OTN_COUNT(FEASIBLE_OFFSETS_EMPTY);
         return {}; // candidate can never fit
     }
 
-    const std::vector<bool> occupied =
-        occupied_slots(parent_level, grooming);
-
+    // Every start whose [start, start + width) run is free, ascending
     std::vector<std::size_t> offsets;
+    const GroomStatus status = dispatch_level(parent_level, [&](auto level) {
+        return feasible_offsets_kernel<level>(grooming, width, offsets);
+    });
 
-    // Left-to-right scan
-    for (std::size_t start = 0; start + width <= max_slots; ++start) {
-        bool fits = true;
+    if (status == GroomStatus::SLOT_OUT_OF_RANGE) {
+        throw std::runtime_error("GroomedChild exceeds parent slot capacity");
+    }
+    if (status != GroomStatus::OK) {
+        throw std::runtime_error("Overlapping GroomedChild slots detected");
+    }
+    if (offsets.empty()) {
+        OTN_COUNT(FEASIBLE_OFFSETS_EMPTY);
+    }
+    return offsets;
+}
 
-        for (std::size_t i = 0; i < width; ++i) {
-            if (occupied[start + i]) {
-                fits = false;
-                break;
-            }
-        }
+// ---------------- FEASIBILITY TABLE ----------------
+
+FeasibilityTable::FeasibilityTable(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming
+)
+    : FeasibilityTable(parent_level, occupied_slot_map(parent_level, grooming))
+{}
+
+FeasibilityTable::FeasibilityTable(OduLevel parent_level, const SlotMap& occupancy)
+    : parent_level_(parent_level)
+{
+    rebuild(occupancy);
+}
 
-        if (fits) {
-            offsets.push_back(start);
+void FeasibilityTable::rebuild(const SlotMap& occupancy) {
+    OTN_COUNT(FEASIBILITY_TABLE_BUILDS);
+
+    occupancy_ = occupancy;
+
+    const std::size_t capacity = occupancy_.capacity();
+    const SlotMap none(capacity);
+
+    // Widths grow 1 -> 4 -> 16 -> 80; each mask extends the previous one
+    SlotMap previous = occupancy_.complement();
+    std::size_t previous_width = 1;
+
+    for (uint8_t l = 1; l < masks_.size(); ++l) {
+        const std::size_t width = tributary_slots(static_cast<OduLevel>(l));
+        if (width > capacity) {
+            masks_[l] = none;
+            continue;
         }
+        masks_[l] = previous.extend_runs(previous_width, width);
+        previous = masks_[l];
+        previous_width = width;
     }
+    masks_[0] = none;
+}
+
+const SlotMap& FeasibilityTable::mask(OduLevel child_level) const {
+    return masks_[static_cast<uint8_t>(child_level)];
+}
+
+bool FeasibilityTable::fits(OduLevel child_level, std::size_t offset) const {
+    return mask(child_level).test(offset);
+}
 
+std::vector<std::size_t> FeasibilityTable::offsets(OduLevel child_level) const {
+    return mask(child_level).to_offsets();
+}
+
+std::vector<std::size_t> feasible_offsets(
+    const FeasibilityTable& table,
+    const Odu& candidate
+) {
+    OTN_COUNT(FEASIBLE_OFFSETS);
+
+    std::vector<std::size_t> offsets = table.offsets(candidate.level());
+    if (offsets.empty()) {
+        OTN_COUNT(FEASIBLE_OFFSETS_EMPTY);
+    }
     return offsets;
 }
 
+SlotMap feasible_offset_mask(
+    OduLevel parent_level,
+    const std::vector<GroomedChild>& grooming,
+    const Odu& candidate
+) {
+    const std::size_t width = tributary_slots(candidate.level());
+    return occupied_slot_map(parent_level, grooming).fit_mask(width);
+}
+
 } // namespace otn
@@ -0,0 +1,292 @@
+#include "otn/instrumentation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace otn {
+namespace instr {
+
+namespace {
+
+/*
+ *  - One block per thread; only the owner writes, with relaxed
+ *    load + store (no read-modify-write), so snapshot() reads are race-free
+ */
+struct ThreadBlock {
+    std::array<std::atomic<uint64_t>, kCounterCount> counters{};
+
+    struct AtomicHistogram {
+        std::array<std::atomic<uint64_t>, kHistogramBuckets> buckets{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum_ns{0};
+        std::atomic<uint64_t> max_ns{0};
+    };
+    std::array<AtomicHistogram, kTimerCount> timers{};
+};
+
+void bump(std::atomic<uint64_t>& a, uint64_t n) {
+    a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+void accumulate(Snapshot& into, const ThreadBlock& b) {
+    for (std::size_t i = 0; i < kCounterCount; ++i) {
+        into.counters[i] += b.counters[i].load(std::memory_order_relaxed);
+    }
+    for (std::size_t t = 0; t < kTimerCount; ++t) {
+        Histogram& h = into.timers[t];
+        const auto& src = b.timers[t];
+        for (std::size_t k = 0; k < kHistogramBuckets; ++k) {
+            h.buckets[k] += src.buckets[k].load(std::memory_order_relaxed);
+        }
+        h.count  += src.count.load(std::memory_order_relaxed);
+        h.sum_ns += src.sum_ns.load(std::memory_order_relaxed);
+        h.max_ns  = std::max(h.max_ns, src.max_ns.load(std::memory_order_relaxed));
+    }
+}
+
+void zero(ThreadBlock& b) {
+    for (auto& c : b.counters) c.store(0, std::memory_order_relaxed);
+    for (auto& h : b.timers) {
+        for (auto& k : h.buckets) k.store(0, std::memory_order_relaxed);
+        h.count.store(0, std::memory_order_relaxed);
+        h.sum_ns.store(0, std::memory_order_relaxed);
+        h.max_ns.store(0, std::memory_order_relaxed);
+    }
+}
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadBlock*> live;
+    Snapshot retired;   // totals of threads that have exited
+};
+
+Registry& registry() {
+    static Registry* r = new Registry();  // never destroyed: threads may outlive statics
+    return *r;
+}
+
+// Plain pointer: the hot path is one TLS load, no init guard
+thread_local ThreadBlock* tls_block = nullptr;
+
+// Set once the slot is destroyed; calls from later thread_local
+// destructors are dropped instead of re-registering
+thread_local bool tls_retired = false;
+
+struct ThreadSlot {
+    ThreadBlock block;
+
+    ThreadSlot() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.live.push_back(&block);
+    }
+
+    ~ThreadSlot() {
+        tls_block = nullptr;
+        tls_retired = true;
+
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        accumulate(r.retired, block);
+        r.live.erase(std::find(r.live.begin(), r.live.end(), &block));
+    }
+};
+
+ThreadBlock* register_thread() {
+    if (tls_retired) return nullptr;
+
+    thread_local ThreadSlot slot;
+    tls_block = &slot.block;
+    return tls_block;
+}
+
+// Null once this thread's slot has been destroyed
+inline ThreadBlock* local_block() {
+    ThreadBlock* b = tls_block;
+    return b ? b : register_thread();
+}
+
+std::size_t bucket_for(uint64_t ns) {
+    if (ns < 2) return 0;
+    const std::size_t b = 63 - static_cast<std::size_t>(__builtin_clzll(ns));
+    return std::min(b, kHistogramBuckets - 1);
+}
+
+} // anonymous namespace
+
+// ---------------- RECORDING ----------------
+
+std::atomic<uint32_t> detail::sample_period{kDefaultTimerSamplePeriod};
+
+void set_timer_sample_period(uint32_t period) {
+    detail::sample_period.store(std::max<uint32_t>(period, 1), std::memory_order_relaxed);
+}
+
+uint32_t timer_sample_period() {
+    return detail::sample_period.load(std::memory_order_relaxed);
+}
+
+void add(Counter c, uint64_t n) {
+    ThreadBlock* b = local_block();
+    if (!b) return;
+    bump(b->counters[static_cast<std::size_t>(c)], n);
+}
+
+void record(Timer t, uint64_t ns) {
+    ThreadBlock* b = local_block();
+    if (!b) return;
+
+    auto& h = b->timers[static_cast<std::size_t>(t)];
+    bump(h.buckets[bucket_for(ns)], 1);
+    bump(h.count, 1);
+    bump(h.sum_ns, ns);
+    if (ns > h.max_ns.load(std::memory_order_relaxed)) {
+        h.max_ns.store(ns, std::memory_order_relaxed);
+    }
+}
+
+Snapshot snapshot() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    Snapshot s = r.retired;
+    for (const ThreadBlock* b : r.live) {
+        accumulate(s, *b);
+    }
+    return s;
+}
+
+void reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    r.retired = Snapshot{};
+    for (ThreadBlock* b : r.live) {
+        zero(*b);
+    }
+}
+
+// ---------------- HISTOGRAM ----------------
+
+double Histogram::mean_ns() const {
+    return count == 0 ? 0.0 : static_cast<double>(sum_ns) / static_cast<double>(count);
+}
+
+uint64_t Histogram::quantile_ns(double q) const {
+    if (count == 0) return 0;
+
+    const double target = std::clamp(q, 0.0, 1.0) * static_cast<double>(count);
+    uint64_t seen = 0;
+    for (std::size_t b = 0; b < kHistogramBuckets; ++b) {
+        seen += buckets[b];
+        if (seen > 0 && static_cast<double>(seen) >= target) {
+            return std::min(max_ns, (uint64_t{2} << b) - 1);
+        }
+    }
+    return max_ns;
+}
+
+// ---------------- NAMES ----------------
+
+const char* name(Counter c) {
+    switch (c) {
+        case Counter::PLAN_GROOMING:            return "plan_grooming";
+        case Counter::PLAN_GROOMING_BLOCKED:    return "plan_grooming_blocked";
+        case Counter::OCCUPIED_SLOTS:           return "occupied_slots";
+        case Counter::FEASIBLE_OFFSETS:         return "feasible_offsets";
+        case Counter::FEASIBLE_OFFSETS_EMPTY:   return "feasible_offsets_empty";
+        case Counter::FEASIBILITY_TABLE_BUILDS: return "feasibility_table_builds";
+        case Counter::ANALYZE_FRAGMENTATION:    return "analyze_fragmentation";
+        case Counter::REPACK:                   return "repack";
+        case Counter::REPACK_BLOCKED:           return "repack_blocked";
+        case Counter::REPACK_OPTIMAL:           return "repack_optimal";
+        case Counter::REPACK_OPTIMAL_NODES:     return "repack_optimal_nodes";
+        case Counter::ADMISSION_EVALUATIONS:    return "admission_evaluations";
+        case Counter::CANDIDATES_CONSIDERED:    return "candidates_considered";
+        case Counter::CANDIDATES_REJECTED:      return "candidates_rejected";
+        case Counter::ADMISSIONS_ACCEPTED:      return "admissions_accepted";
+        case Counter::ADMISSIONS_BLOCKED:       return "admissions_blocked";
+        case Counter::ODU_AGGREGATIONS:         return "odu_aggregations";
+        case Counter::ODU_AGGREGATIONS_FAILED:  return "odu_aggregations_failed";
+        case Counter::MUX_CALLS:                return "mux_calls";
+        case Counter::MUX_FAILURES:             return "mux_failures";
+        case Counter::COUNT_:                   break;
+    }
+    return "unknown";
+}
+
+const char* name(Timer t) {
+    switch (t) {
+        case Timer::PLAN_GROOMING:         return "plan_grooming";
+        case Timer::FEASIBLE_OFFSETS:      return "feasible_offsets";
+        case Timer::ANALYZE_FRAGMENTATION: return "analyze_fragmentation";
+        case Timer::REPACK:                return "repack";
+        case Timer::REPACK_OPTIMAL:        return "repack_optimal";
+        case Timer::ADMISSION:             return "admission";
+        case Timer::ODU_AGGREGATION:       return "odu_aggregation";
+        case Timer::COUNT_:                break;
+    }
+    return "unknown";
+}
+
+// ---------------- DUMPS ----------------
+
+std::string to_json(const Snapshot& s) {
+    std::ostringstream out;
+    out << "{\n  \"counters\": {";
+    for (std::size_t i = 0; i < kCounterCount; ++i) {
+        out << (i ? "," : "") << "\n    \"" << name(static_cast<Counter>(i))
+            << "\": " << s.counters[i];
+    }
+    out << "\n  },\n  \"timers\": {";
+    for (std::size_t t = 0; t < kTimerCount; ++t) {
+        const Histogram& h = s.timers[t];
+        out << (t ? "," : "") << "\n    \"" << name(static_cast<Timer>(t)) << "\": {"
+            << "\"count\": " << h.count
+            << ", \"sum_ns\": " << h.sum_ns
+            << ", \"max_ns\": " << h.max_ns
+            << ", \"mean_ns\": " << h.mean_ns()
+            << ", \"p50_ns\": " << h.quantile_ns(0.50)
+            << ", \"p99_ns\": " << h.quantile_ns(0.99)
+            << ", \"buckets\": [";
+        for (std::size_t b = 0; b < kHistogramBuckets; ++b) {
+            out << (b ? ", " : "") << h.buckets[b];
+        }
+        out << "]}";
+    }
+    out << "\n  }\n}\n";
+    return out.str();
+}
+
+std::string to_prometheus(const Snapshot& s) {
+    std::ostringstream out;
+
+    for (std::size_t i = 0; i < kCounterCount; ++i) {
+        const char* n = name(static_cast<Counter>(i));
+        out << "# TYPE otn_" << n << "_total counter\n"
+            << "otn_" << n << "_total " << s.counters[i] << "\n";
+    }
+
+    for (std::size_t t = 0; t < kTimerCount; ++t) {
+        const Histogram& h = s.timers[t];
+        const std::string metric = std::string("otn_") + name(static_cast<Timer>(t)) + "_seconds";
+
+        out << "# TYPE " << metric << " histogram\n";
+        uint64_t cumulative = 0;
+        for (std::size_t b = 0; b < kHistogramBuckets; ++b) {
+            cumulative += h.buckets[b];
+            const double le = static_cast<double>(uint64_t{2} << b) * 1e-9;
+            out << metric << "_bucket{le=\"" << le << "\"} " << cumulative << "\n";
+        }
+        out << metric << "_bucket{le=\"+Inf\"} " << h.count << "\n"
+            << metric << "_sum " << static_cast<double>(h.sum_ns) * 1e-9 << "\n"
+            << metric << "_count " << h.count << "\n";
+    }
+    return out.str();
+}
+
+} // namespace instr
+} // namespace otn
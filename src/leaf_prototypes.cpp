@@ -0,0 +1,11 @@
+#include "otn/leaf_prototypes.hpp"
+
+namespace otn {
+
+LeafPrototypes::LeafPrototypes() {
+    for (uint8_t l = static_cast<uint8_t>(OduLevel::ODU1); l <= static_cast<uint8_t>(OduLevel::ODU4); ++l) {
+        leaves_.emplace_back(static_cast<OduLevel>(l), 0);
+    }
+}
+
+} // namespace otn
@@ -1,12 +1,77 @@
+#include <exception>
+#include <filesystem>
 #include <iostream>
+#include <string>
 #include "otn/payload.hpp"
 #include "otn/opu.hpp"
 #include "otn/odu.hpp"
 #include "otn/otu.hpp"
+#include "otn/scenario.hpp"
 
-int main() {
+namespace {
+
+void print_usage(std::ostream& out) {
+    out << "usage: otn_sim [scenario-file] [key=value ...]\n"
+           "  Runs the scenario (keys as in the file) and reports wall time,\n"
+           "  throughput, blocking and fragmentation; key=value arguments\n"
+           "  override the file. The first argument is the scenario file if it\n"
+           "  names an existing file or has no '='. Without arguments prints a\n"
+           "  layer demo.\n"
+           "  Admission policies:";
+    for (const std::string& name : otn::cost_policy_names()) out << " " << name;
+    out << "\n";
+}
+
+int run(int argc, char** argv) {
+    using namespace otn;
+
+    // A path may itself contain '=', so an existing file always wins
+    const std::string first = argv[1];
+    const bool first_is_file =
+        std::filesystem::is_regular_file(first) || first.find('=') == std::string::npos;
+
+    Scenario scenario;
+    int first_override = 1;
+    if (first_is_file) {
+        scenario = load_scenario(first);
+        first_override = 2;
+    }
+
+    for (int i = first_override; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto eq = arg.find('=');
+        if (eq == std::string::npos) {
+            print_usage(std::cerr);
+            return 2;
+        }
+        apply_scenario_setting(scenario, arg.substr(0, eq), arg.substr(eq + 1));
+    }
+
+    const ScenarioReport report = run_scenario(scenario);
+    print_report(std::cout, scenario, report);
+    return 0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
     using namespace otn;
 
+    if (argc > 1) {
+        const std::string arg = argv[1];
+        if (arg == "-h" || arg == "--help") {
+            print_usage(std::cout);
+            return 0;
+        }
+
+        try {
+            return run(argc, argv);
+        } catch (const std::exception& e) {
+            std::cerr << "otn_sim: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
     Payload payload(1500);
     Opu opu(payload);
     Odu odu(OduLevel::ODU2, opu);
@@ -0,0 +1,85 @@
+#include "otn/mapped_file.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace otn {
+
+namespace {
+
+// Closes the descriptor on every exit path of the constructor
+struct FileDescriptor {
+    int fd;
+    ~FileDescriptor() { if (fd >= 0) ::close(fd); }
+};
+
+} // anonymous namespace
+
+MappedFile::MappedFile(const std::string& path) {
+    FileDescriptor file{::open(path.c_str(), O_RDONLY)};
+    if (file.fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    struct stat st;
+    if (::fstat(file.fd, &st) != 0) {
+        throw std::runtime_error("Cannot stat file: " + path);
+    }
+
+    const std::size_t bytes = static_cast<std::size_t>(st.st_size);
+    if (bytes == 0) return;
+
+    void* data = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, file.fd, 0);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    data_ = data;
+    bytes_ = bytes;
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      bytes_(std::exchange(other.bytes_, 0))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        bytes_ = std::exchange(other.bytes_, 0);
+    }
+    return *this;
+}
+
+void MappedFile::unmap() noexcept {
+    if (data_) {
+        ::munmap(data_, bytes_);
+        data_ = nullptr;
+        bytes_ = 0;
+    }
+}
+
+void MappedFile::advise_sequential() const {
+    if (data_) {
+        ::madvise(data_, bytes_, MADV_SEQUENTIAL);
+    }
+}
+
+void MappedFile::release_prefix(std::size_t bytes) const {
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t whole = (bytes < bytes_ ? bytes : bytes_) / page * page;
+    if (data_ && whole > 0) {
+        ::madvise(data_, whole, MADV_DONTNEED);
+    }
+}
+
+} // namespace otn
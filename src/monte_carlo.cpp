@@ -0,0 +1,135 @@
+#include "otn/monte_carlo.hpp"
+#include "otn/parallel.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace otn {
+
+namespace {
+
+uint64_t splitmix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Two-sided 95% Student t quantile for the given degrees of freedom
+double t_quantile_95(std::size_t dof) {
+    static const double table[] = {
+        0.0,    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+        2.228,  2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093,
+        2.086,  2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045,
+        2.042
+    };
+    if (dof < sizeof(table) / sizeof(table[0])) return table[dof];
+    if (dof < 60)  return 2.000;
+    if (dof < 120) return 1.980;
+    return 1.960;
+}
+
+} // anonymous namespace
+
+uint64_t replication_seed(uint64_t base_seed, std::size_t load_index, std::size_t replication) {
+    uint64_t s = splitmix64(base_seed);
+    s = splitmix64(s ^ static_cast<uint64_t>(load_index));
+    return splitmix64(s ^ static_cast<uint64_t>(replication));
+}
+
+Estimate estimate(const std::vector<double>& samples) {
+    Estimate e;
+    e.samples = samples.size();
+    if (samples.empty()) return e;
+
+    double sum = 0.0;
+    for (double x : samples) sum += x;
+    e.mean = sum / static_cast<double>(samples.size());
+
+    if (samples.size() < 2) return e;
+
+    double sq = 0.0;
+    for (double x : samples) sq += (x - e.mean) * (x - e.mean);
+    e.stddev = std::sqrt(sq / static_cast<double>(samples.size() - 1));
+    e.ci_half_width = t_quantile_95(samples.size() - 1) * e.stddev /
+                      std::sqrt(static_cast<double>(samples.size()));
+    return e;
+}
+
+MonteCarloResult run_monte_carlo(const MonteCarloConfig& config) {
+    if (config.loads.empty()) {
+        throw std::runtime_error("Monte Carlo sweep needs at least one load point");
+    }
+    if (config.replications == 0) {
+        throw std::runtime_error("Monte Carlo sweep needs at least one replication");
+    }
+    for (double load : config.loads) {
+        if (!(load > 0.0)) {
+            throw std::runtime_error("Offered load must be positive");
+        }
+    }
+
+    const std::size_t reps = config.replications;
+    std::vector<SimulationStats> runs(config.loads.size() * reps);
+
+    parallel_for(runs.size(), config.threads, [&](std::size_t i) {
+        const std::size_t point = i / reps;
+
+        SimulationConfig sim = config.base;
+        sim.arrival_rate = config.loads[point] / sim.mean_holding_time;
+        sim.seed = replication_seed(config.base_seed, point, i % reps);
+
+        runs[i] = Simulator(std::move(sim)).run();
+    });
+
+    // ---------------- REDUCTION (index order) ----------------
+
+    MonteCarloResult result;
+    result.points.reserve(config.loads.size());
+
+    std::vector<double> blocking, utilization, cost;
+    std::array<std::vector<double>, 5> per_level;
+
+    for (std::size_t point = 0; point < config.loads.size(); ++point) {
+        LoadPointResult r;
+        r.offered_load = config.loads[point];
+
+        blocking.clear();
+        utilization.clear();
+        cost.clear();
+        for (auto& v : per_level) v.clear();
+
+        for (std::size_t rep = 0; rep < reps; ++rep) {
+            const SimulationStats& s = runs[point * reps + rep];
+            result.total_events += s.events;
+
+            blocking.push_back(s.blocking_probability);
+            utilization.push_back(s.mean_utilization);
+            cost.push_back(s.mean_fragmentation_cost);
+
+            for (std::size_t l = 0; l < per_level.size(); ++l) {
+                r.arrivals_per_level[l] += s.arrivals_per_level[l];
+                r.blocked_per_level[l] += s.blocked_per_level[l];
+                if (s.arrivals_per_level[l] > 0) {
+                    per_level[l].push_back(
+                        static_cast<double>(s.blocked_per_level[l]) /
+                        static_cast<double>(s.arrivals_per_level[l])
+                    );
+                }
+            }
+        }
+
+        r.blocking = estimate(blocking);
+        r.utilization = estimate(utilization);
+        r.fragmentation_cost = estimate(cost);
+        for (std::size_t l = 0; l < per_level.size(); ++l) {
+            r.blocking_per_level[l] = estimate(per_level[l]);
+        }
+
+        result.points.push_back(r);
+    }
+
+    return result;
+}
+
+} // namespace otn
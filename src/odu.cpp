@@ -1,4 +1,7 @@
 #include "otn/odu.hpp"
+#include "otn/instrumentation.hpp"
+#include "otn/slot_map.hpp"
+#include <algorithm>
 #include <stdexcept>
 
 namespace otn {
@@ -18,6 +21,23 @@ size_t capacity_for_level(OduLevel level) {
 }
 */
 
+SubtreeSummary leaf_summary(OduLevel level, size_t payload_bytes) {
+    SubtreeSummary s;
+    s.leaf_count = 1;
+    s.leaf_payload_bytes = payload_bytes;
+    s.leaves_per_level[static_cast<uint8_t>(level)] = 1;
+    return s;
+}
+
+void merge_child_summary(SubtreeSummary& into, const SubtreeSummary& child) {
+    into.leaf_count += child.leaf_count;
+    into.leaf_payload_bytes += child.leaf_payload_bytes;
+    into.depth = std::max(into.depth, child.depth + 1);
+    for (size_t l = 0; l < into.leaves_per_level.size(); ++l) {
+        into.leaves_per_level[l] += child.leaves_per_level[l];
+    }
+}
+
 } // anonymous namespace
 
 // ---------------- LEAF ODU ----------------
@@ -25,7 +45,8 @@ size_t capacity_for_level(OduLevel level) {
 Odu::Odu(OduLevel level, size_t payload)
     : level_(level),
       payload_bytes_(payload),
-      slot_count_(tributary_slots(level))
+      slot_count_(tributary_slots(level)),
+      summary_(leaf_summary(level, payload))
 {
     if (payload > nominal_capacity(level)) {
         throw std::runtime_error("ODU payload exceeds nominal capacity");
@@ -37,7 +58,8 @@ Odu::Odu(OduLevel level, size_t payload)
 Odu::Odu(OduLevel level, const Opu& opu)
     : level_(level),
       payload_bytes_(opu.payload_size()),
-      slot_count_(tributary_slots(level))
+      slot_count_(tributary_slots(level)),
+      summary_(leaf_summary(level, opu.payload_size()))
 {}
 
 // DEPRECATED FOR GROOMING MODEL ---------------- AGGREGATED ODU ----------------
@@ -60,43 +82,103 @@ Odu::Odu(OduLevel level, const Opu& opu)
 
 // ---------------- AGGREGATED ODU w/EXPLICIT GROOMING ----------------
 
-Odu::Odu(OduLevel level, std::vector<GroomedChild> groomed)
-    : level_(level),
-      payload_bytes_(0),
-      slot_count_(0),
-      groomed_children_(std::move(groomed))
-{
-    const size_t parent_slots = tributary_slots(level_);
-    std::vector<bool> slot_map(parent_slots, false);
+GroomStatus Odu::check_grooming(
+    OduLevel level,
+    const std::vector<GroomedChild>& groomed,
+    size_t& payload_bytes,
+    size_t& slot_count
+) {
+    OTN_COUNT(ODU_AGGREGATIONS);
+    OTN_TIME_SCOPE(ODU_AGGREGATION);
 
-    for (const auto& gc : groomed_children_) {
+    const size_t parent_slots = tributary_slots(level);
+    SlotMap slot_map(parent_slots);
+
+    payload_bytes = 0;
+    slot_count = 0;
+
+    for (const auto& gc : groomed) {
         const Odu& child = *(gc.child);
         const size_t offset = gc.slot_offset;
         const size_t child_slots = child.slots();
 
         // Child must be exactly one level lower
         uint8_t child_lvl  = static_cast<uint8_t>(child.level());
-        uint8_t parent_lvl = static_cast<uint8_t>(level_);
+        uint8_t parent_lvl = static_cast<uint8_t>(level);
         if (parent_lvl != child_lvl + 1) {
-            throw std::runtime_error("Invalid ODU level hierarchy");
+            OTN_COUNT(ODU_AGGREGATIONS_FAILED);
+            return GroomStatus::INVALID_HIERARCHY;
         }
 
         // Bounds check
         if (offset + child_slots > parent_slots) {
-            throw std::runtime_error("Groomed child exceeds parent slot range");
+            OTN_COUNT(ODU_AGGREGATIONS_FAILED);
+            return GroomStatus::SLOT_OUT_OF_RANGE;
         }
 
         // Overlap check
-        for (size_t i = 0; i < child_slots; ++i) {
-            if (slot_map[offset + i]) {
-                throw std::runtime_error("Overlapping tributary slots");
-            }
-            slot_map[offset + i] = true;
+        if (!slot_map.range_free(offset, child_slots)) {
+            OTN_COUNT(ODU_AGGREGATIONS_FAILED);
+            return GroomStatus::OVERLAPPING_SLOTS;
         }
+        slot_map.set_range(offset, child_slots);
 
-        slot_count_   += child_slots;
-        payload_bytes_ += child.payload_size();
+        slot_count    += child_slots;
+        payload_bytes += child.payload_size();
+    }
+
+    return GroomStatus::OK;
+}
+
+const char* Odu::grooming_error(GroomStatus status) {
+    switch (status) {
+        case GroomStatus::INVALID_HIERARCHY: return "Invalid ODU level hierarchy";
+        case GroomStatus::SLOT_OUT_OF_RANGE: return "Groomed child exceeds parent slot range";
+        case GroomStatus::OVERLAPPING_SLOTS: return "Overlapping tributary slots";
+        default:                             return to_string(status);
+    }
+}
+
+Odu::Odu(OduLevel level, std::vector<GroomedChild> groomed)
+    : level_(level),
+      payload_bytes_(0),
+      slot_count_(0),
+      groomed_children_(std::move(groomed))
+{
+    const GroomStatus status =
+        check_grooming(level_, groomed_children_, payload_bytes_, slot_count_);
+    if (status != GroomStatus::OK) {
+        throw std::runtime_error(grooming_error(status));
+    }
+
+    summary_ = is_aggregated() ? summarize_children()
+                               : leaf_summary(level_, payload_bytes_);
+}
+
+GroomStatus Odu::try_groom(
+    OduLevel level,
+    std::vector<GroomedChild> groomed,
+    Odu& out
+) {
+    size_t payload_bytes = 0;
+    size_t slot_count = 0;
+
+    const GroomStatus status = check_grooming(level, groomed, payload_bytes, slot_count);
+    if (status == GroomStatus::OK) {
+        out = Odu(level, std::move(groomed), payload_bytes, slot_count);
     }
+    return status;
+}
+
+Odu::Odu(OduLevel level, std::vector<GroomedChild> groomed,
+         size_t payload_bytes, size_t slot_count)
+    : level_(level),
+      payload_bytes_(payload_bytes),
+      slot_count_(slot_count),
+      groomed_children_(std::move(groomed))
+{
+    summary_ = is_aggregated() ? summarize_children()
+                               : leaf_summary(level_, payload_bytes_);
 }
 
 // ---------------- ACCESSORS ----------------
@@ -117,6 +199,56 @@ bool Odu::is_aggregated() const {
     return !groomed_children_.empty();
 }
 
+const std::vector<GroomedChild>& Odu::groomed_children() const {
+    return groomed_children_;
+}
+
+// ---------------- SUBTREE SUMMARY ----------------
+
+const SubtreeSummary& Odu::summary() const {
+    return summary_;
+}
+
+size_t Odu::leaf_count() const {
+    return summary_.leaf_count;
+}
+
+size_t Odu::depth() const {
+    return summary_.depth;
+}
+
+SubtreeSummary Odu::summarize_children() const {
+    SubtreeSummary s;
+    for (const auto& gc : groomed_children_) {
+        merge_child_summary(s, gc.child->summary_);
+    }
+    return s;
+}
+
+void Odu::refresh_summary() {
+    if (!is_aggregated()) return;
+
+    payload_bytes_ = 0;
+    slot_count_ = 0;
+    for (const auto& gc : groomed_children_) {
+        payload_bytes_ += gc.child->payload_size();
+        slot_count_ += gc.child->slots();
+    }
+    summary_ = summarize_children();
+}
+
+SubtreeSummary Odu::compute_summary(const Odu& root) {
+    if (!root.is_aggregated()) {
+        return leaf_summary(root.level_, root.payload_bytes_);
+    }
+
+    SubtreeSummary s;
+    for (const auto& gc : root.groomed_children_) {
+        merge_child_summary(s, compute_summary(*gc.child));
+    }
+    return s;
+}
+
 // ---------------- MUX ----------------
 
 MuxResult mux(
@@ -124,7 +256,10 @@ MuxResult mux(
     const std::vector<GroomedChild>& groomed_children,
     Odu& out_parent
 ) {
+    OTN_COUNT(MUX_CALLS);
+
     if (groomed_children.empty()) {
+        OTN_COUNT(MUX_FAILURES);
         return MuxResult::invalid_hierarchy("Can't mux without children");
     }
 
@@ -132,6 +267,7 @@ MuxResult mux(
     OduLevel expected = groomed_children.front().child->level();
     for (const auto& gc : groomed_children) {
         if (gc.child->level() != expected) {
+            OTN_COUNT(MUX_FAILURES);
             return MuxResult::invalid_hierarchy(
                 "All children must have same ODU level"
             );
@@ -142,16 +278,17 @@ MuxResult mux(
     uint8_t child_lvl  = static_cast<uint8_t>(expected);
     uint8_t parent_lvl = static_cast<uint8_t>(parent_level);
     if (parent_lvl != child_lvl + 1) {
+        OTN_COUNT(MUX_FAILURES);
         return MuxResult::invalid_hierarchy(
             "ODU levels must be adjacent"
         );
     }
 
-    // construction enforces slot placement + overlap rules
-    try {
-        out_parent = Odu(parent_level, groomed_children);
-    } catch (const std::exception& e) {
-        return MuxResult::insufficient_capacity(e.what());
+    // slot placement + overlap rules, checked without throwing
+    const GroomStatus status = Odu::try_groom(parent_level, groomed_children, out_parent);
+    if (status != GroomStatus::OK) {
+        OTN_COUNT(MUX_FAILURES);
+        return MuxResult::insufficient_capacity(Odu::grooming_error(status));
     }
 
     return MuxResult::success();
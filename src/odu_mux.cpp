@@ -0,0 +1,151 @@
+#include "otn/odu_mux.hpp"
+
+#include <stdexcept>
+
+namespace otn {
+
+OduMux::OduMux(OduLevel target_level, ExtentFit fit)
+    : target_level_(target_level),
+      fit_(fit),
+      max_capacity_(capacity_for_level(target_level)),
+      used_capacity_(0),
+      payload_bytes_(0),
+      occupancy_(max_capacity_),
+      extents_(fit == ExtentFit::FIRST ? 0 : max_capacity_),
+      cached_width_(SlotMap::npos),
+      cached_offset_(SlotMap::npos)
+{}
+
+size_t OduMux::capacity_for_level(OduLevel level) const {
+    return tributary_slots(level);
+}
+
+bool OduMux::is_valid_client(const Odu& client) const {
+    // Client must be exactly one level lower
+    uint8_t child_lvl  = static_cast<uint8_t>(client.level());
+    uint8_t parent_lvl = static_cast<uint8_t>(target_level_);
+    return parent_lvl == child_lvl + 1;
+}
+
+size_t OduMux::find_offset(size_t width) const {
+    if (width != cached_width_) {
+        // First fit stays on the bitmap; the extent index is only kept for the others
+        cached_offset_ = fit_ == ExtentFit::FIRST
+            ? occupancy_.find_first_fit(width)
+            : extents_.fit(fit_, width);
+        cached_width_ = width;
+    }
+    return cached_offset_;
+}
+
+// ---------------- STREAMING ADD / REMOVE ----------------
+
+bool OduMux::can_accept(const Odu& client) const {
+    return is_valid_client(client) &&
+           client_index_.find(&client) == client_index_.end() &&
+           find_offset(client.slots()) != SlotMap::npos;
+}
+
+MuxResult OduMux::add_client(const Odu& client) {
+    if (!is_valid_client(client)) {
+        return MuxResult::invalid_hierarchy("ODU levels must be adjacent");
+    }
+    if (client_index_.find(&client) != client_index_.end()) {
+        return MuxResult::invalid_hierarchy("Client already multiplexed");
+    }
+
+    const size_t width = client.slots();
+    const size_t offset = find_offset(width);
+    if (offset == SlotMap::npos) {
+        return MuxResult::insufficient_capacity("Insufficient tributary slots");
+    }
+
+    occupancy_.set_range(offset, width);
+    if (fit_ != ExtentFit::FIRST) extents_.allocate(offset, width);
+    cached_width_ = SlotMap::npos;
+
+    client_index_.emplace(&client, clients_.size());
+    clients_.emplace_back(&client, width, offset);
+    client_payloads_.push_back(client.payload_size());
+
+    used_capacity_ += width;
+    payload_bytes_ += client_payloads_.back();
+
+    return MuxResult::success();
+}
+
+MuxResult OduMux::remove_client(const Odu& client) {
+    auto it = client_index_.find(&client);
+    if (it == client_index_.end()) {
+        return MuxResult::invalid_hierarchy("Unknown client");
+    }
+
+    const size_t index = it->second;
+    const GroomedChild removed = clients_[index];
+
+    occupancy_.clear_range(removed.slot_offset, removed.slot_width);
+    if (fit_ != ExtentFit::FIRST) extents_.release(removed.slot_offset, removed.slot_width);
+    cached_width_ = SlotMap::npos;
+
+    // What was added, even if the client's payload has changed since
+    used_capacity_ -= removed.slot_width;
+    payload_bytes_ -= client_payloads_[index];
+
+    // Swap-remove keeps removal O(1)
+    if (index + 1 != clients_.size()) {
+        clients_[index] = clients_.back();
+        client_payloads_[index] = client_payloads_.back();
+        client_index_[clients_[index].child] = index;
+    }
+    clients_.pop_back();
+    client_payloads_.pop_back();
+    client_index_.erase(it);
+
+    return MuxResult::success();
+}
+
+// ---------------- CAPACITY ----------------
+
+bool OduMux::is_full() const {
+    return occupancy_.count() == max_capacity_;
+}
+
+size_t OduMux::used_capacity() const {
+    return used_capacity_;
+}
+
+size_t OduMux::remaining_capacity() const {
+    return max_capacity_ - used_capacity_;
+}
+
+size_t OduMux::client_count() const {
+    return clients_.size();
+}
+
+const std::vector<GroomedChild>& OduMux::grooming() const {
+    return clients_;
+}
+
+// ---------------- OUTPUT ----------------
+
+Odu OduMux::multiplex() const {
+    if (clients_.empty()) {
+        throw std::runtime_error("Can't mux without children");
+    }
+
+    // Every placement was checked on arrival; no need to re-validate
+    return Odu(target_level_, clients_, payload_bytes_, used_capacity_);
+}
+
+void OduMux::reset() {
+    occupancy_ = SlotMap(max_capacity_);
+    extents_ = FreeExtentIndex(fit_ == ExtentFit::FIRST ? 0 : max_capacity_);
+    clients_.clear();
+    client_payloads_.clear();
+    client_index_.clear();
+    used_capacity_ = 0;
+    payload_bytes_ = 0;
+    cached_width_ = SlotMap::npos;
+}
+
+} // namespace otn
@@ -0,0 +1,169 @@
+#include "otn/odu_snapshot.hpp"
+#include "otn/slot_map.hpp"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace otn {
+
+namespace {
+
+std::uint64_t align8(std::uint64_t n) {
+    return (n + 7) & ~std::uint64_t{7};
+}
+
+} // anonymous namespace
+
+// ---------------- LAYOUT ----------------
+
+SnapshotHeader snapshot_layout(std::size_t odu_count, std::size_t child_count) {
+    SnapshotHeader h{};
+    std::memcpy(h.magic, kSnapshotMagic, sizeof(h.magic));
+    h.version = kSnapshotVersion;
+    h.endian_tag = kSnapshotEndianTag;
+    h.odu_count = odu_count;
+    h.child_count = child_count;
+
+    // Widest records first, so every section is naturally aligned
+    std::uint64_t pos = align8(sizeof(SnapshotHeader));
+    h.payload_bytes_offset = pos;
+    pos = align8(pos + odu_count * sizeof(std::uint64_t));
+    h.children_offset = pos;
+    pos = align8(pos + child_count * sizeof(StoredChild));
+    h.first_child_offset = pos;
+    pos = align8(pos + odu_count * sizeof(std::uint32_t));
+    h.level_offset = pos;
+    pos = align8(pos + odu_count);
+    h.slot_count_offset = pos;
+    pos = align8(pos + odu_count);
+    h.child_count_offset = pos;
+    h.file_bytes = align8(pos + odu_count);
+
+    return h;
+}
+
+// ---------------- MAPPING ----------------
+
+MappedSnapshot::MappedSnapshot(const std::string& path) : file_(path) {
+    if (file_.size() < sizeof(SnapshotHeader)) {
+        throw std::runtime_error("Truncated ODU snapshot");
+    }
+
+    SnapshotHeader h;
+    std::memcpy(&h, file_.data(), sizeof(h));
+
+    const char* error = nullptr;
+    if (std::memcmp(h.magic, kSnapshotMagic, sizeof(h.magic)) != 0) {
+        error = "Not an ODU snapshot";
+    } else if (h.endian_tag != kSnapshotEndianTag) {
+        error = "ODU snapshot has foreign byte order";
+    } else if (h.version != kSnapshotVersion) {
+        error = "Unsupported ODU snapshot version";
+    } else if (h.odu_count > std::numeric_limits<std::uint32_t>::max() ||
+               h.child_count > std::numeric_limits<std::uint32_t>::max()) {
+        error = "Corrupt ODU snapshot header";
+    } else if (h.file_bytes != file_.size()) {
+        error = "Truncated ODU snapshot";
+    } else {
+        // Offsets must be exactly what this version's writer produces
+        const SnapshotHeader expected = snapshot_layout(h.odu_count, h.child_count);
+        if (std::memcmp(&h, &expected, sizeof(h)) != 0) {
+            error = "Corrupt ODU snapshot header";
+        }
+    }
+    if (error) {
+        throw std::runtime_error(error);
+    }
+
+    const char* base = file_.data();
+    odu_count_ = h.odu_count;
+    child_count_total_ = h.child_count;
+    payload_bytes_ = reinterpret_cast<const std::uint64_t*>(base + h.payload_bytes_offset);
+    children_      = reinterpret_cast<const StoredChild*>(base + h.children_offset);
+    first_child_   = reinterpret_cast<const std::uint32_t*>(base + h.first_child_offset);
+    level_         = reinterpret_cast<const OduLevel*>(base + h.level_offset);
+    slot_count_    = reinterpret_cast<const std::uint8_t*>(base + h.slot_count_offset);
+    child_count_   = reinterpret_cast<const std::uint8_t*>(base + h.child_count_offset);
+}
+
+MappedSnapshot::MappedSnapshot(MappedSnapshot&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedSnapshot& MappedSnapshot::operator=(MappedSnapshot&& other) noexcept {
+    if (this != &other) {
+        file_              = std::move(other.file_);
+        odu_count_         = std::exchange(other.odu_count_, 0);
+        child_count_total_ = std::exchange(other.child_count_total_, 0);
+        payload_bytes_     = std::exchange(other.payload_bytes_, nullptr);
+        children_          = std::exchange(other.children_, nullptr);
+        first_child_       = std::exchange(other.first_child_, nullptr);
+        level_             = std::exchange(other.level_, nullptr);
+        slot_count_        = std::exchange(other.slot_count_, nullptr);
+        child_count_       = std::exchange(other.child_count_, nullptr);
+    }
+    return *this;
+}
+
+// ---------------- VERIFICATION ----------------
+
+void MappedSnapshot::verify() const {
+    for (std::size_t i = 0; i < odu_count_; ++i) {
+        const uint8_t lvl = static_cast<uint8_t>(level_[i]);
+        if (lvl < 1 || lvl > 4) {
+            throw std::runtime_error("Unknown ODU level");
+        }
+
+        const std::size_t parent_slots = tributary_slots(level_[i]);
+        if (child_count_[i] == 0) {
+            // A leaf, or an aggregate that was groomed with no children
+            const bool empty_aggregate = slot_count_[i] == 0 && payload_bytes_[i] == 0;
+            if (slot_count_[i] != parent_slots && !empty_aggregate) {
+                throw std::runtime_error("Corrupt ODU snapshot: leaf slot count");
+            }
+            continue;
+        }
+
+        if (static_cast<std::size_t>(first_child_[i]) + child_count_[i] > child_count_total_) {
+            throw std::runtime_error("Corrupt ODU snapshot: child range");
+        }
+
+        SlotMap slot_map(parent_slots);
+        std::size_t slot_count = 0;
+        std::uint64_t payload_bytes = 0;
+
+        for (const StoredChild& c : children(OduHandle{static_cast<std::uint32_t>(i)})) {
+            // Stores add children before parents
+            if (c.child.index >= i) {
+                throw std::runtime_error("Unknown ODU handle in grooming");
+            }
+            if (static_cast<uint8_t>(level_[c.child.index]) + 1 != lvl) {
+                throw std::runtime_error("Invalid ODU level hierarchy");
+            }
+            if (c.slot_width != slot_count_[c.child.index]) {
+                throw std::runtime_error("Corrupt ODU snapshot: child slot width");
+            }
+            if (c.slot_width == 0) {
+                throw std::runtime_error("Groomed child occupies no tributary slots");
+            }
+            if (c.slot_offset + c.slot_width > parent_slots) {
+                throw std::runtime_error("Groomed child exceeds parent slot range");
+            }
+            if (!slot_map.range_free(c.slot_offset, c.slot_width)) {
+                throw std::runtime_error("Overlapping tributary slots");
+            }
+            slot_map.set_range(c.slot_offset, c.slot_width);
+
+            slot_count += c.slot_width;
+            payload_bytes += payload_bytes_[c.child.index];
+        }
+
+        if (slot_count != slot_count_[i] || payload_bytes != payload_bytes_[i]) {
+            throw std::runtime_error("Corrupt ODU snapshot: aggregate totals");
+        }
+    }
+}
+
+} // namespace otn
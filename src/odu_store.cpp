@@ -0,0 +1,231 @@
+#include "otn/odu_store.hpp"
+#include "otn/odu_snapshot.hpp"
+#include "otn/slot_map.hpp"
+
+#include <fstream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace otn {
+
+void OduStore::reserve(std::size_t odus, std::size_t children) {
+    level_.reserve(odus);
+    payload_bytes_.reserve(odus);
+    slot_count_.reserve(odus);
+    first_child_.reserve(odus);
+    child_count_.reserve(odus);
+    children_.reserve(children);
+}
+
+OduHandle OduStore::push_node(
+    OduLevel level,
+    std::size_t payload_bytes,
+    std::size_t slots,
+    std::size_t first_child,
+    std::size_t child_count
+) {
+    if (level_.size() >= std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("OduStore handle space exhausted");
+    }
+
+    const OduHandle h{static_cast<std::uint32_t>(level_.size())};
+
+    level_.push_back(level);
+    payload_bytes_.push_back(payload_bytes);
+    slot_count_.push_back(static_cast<std::uint8_t>(slots));
+    first_child_.push_back(static_cast<std::uint32_t>(first_child));
+    child_count_.push_back(static_cast<std::uint8_t>(child_count));
+
+    return h;
+}
+
+// ---------------- LEAF ODU ----------------
+
+OduHandle OduStore::add_leaf(OduLevel level, std::size_t payload_bytes) {
+    if (payload_bytes > nominal_capacity(level)) {
+        throw std::runtime_error("ODU payload exceeds nominal capacity");
+    }
+
+    return push_node(level, payload_bytes, tributary_slots(level), children_.size(), 0);
+}
+
+// ---------------- AGGREGATED ODU ----------------
+
+OduHandle OduStore::add_aggregate(
+    OduLevel level,
+    const std::vector<ChildPlacement>& children
+) {
+    // child_count_ is 8 bits wide
+    if (children.size() > std::numeric_limits<std::uint8_t>::max()) {
+        throw std::runtime_error("Too many groomed children");
+    }
+
+    const std::size_t parent_slots = tributary_slots(level);
+    SlotMap slot_map(parent_slots);
+
+    std::size_t payload_bytes = 0;
+    std::size_t slot_count = 0;
+
+    // Validate everything before touching the arrays
+    for (const auto& placement : children) {
+        if (!contains(placement.child)) {
+            throw std::runtime_error("Unknown ODU handle in grooming");
+        }
+
+        const OduHandle child = placement.child;
+        const std::size_t offset = placement.slot_offset;
+        const std::size_t child_slots = slots(child);
+
+        // Child must be exactly one level lower
+        uint8_t child_lvl  = static_cast<uint8_t>(level_[child.index]);
+        uint8_t parent_lvl = static_cast<uint8_t>(level);
+        if (parent_lvl != child_lvl + 1) {
+            throw std::runtime_error("Invalid ODU level hierarchy");
+        }
+
+        // A zero-width child (an empty aggregate) would fit anywhere, any number of times
+        if (child_slots == 0) {
+            throw std::runtime_error("Groomed child occupies no tributary slots");
+        }
+
+        if (offset + child_slots > parent_slots) {
+            throw std::runtime_error("Groomed child exceeds parent slot range");
+        }
+
+        if (!slot_map.range_free(offset, child_slots)) {
+            throw std::runtime_error("Overlapping tributary slots");
+        }
+        slot_map.set_range(offset, child_slots);
+
+        slot_count   += child_slots;
+        payload_bytes += payload_bytes_[child.index];
+    }
+
+    const std::size_t first_child = children_.size();
+    for (const auto& placement : children) {
+        children_.push_back({
+            placement.child,
+            static_cast<std::uint16_t>(slots(placement.child)),
+            static_cast<std::uint16_t>(placement.slot_offset)
+        });
+    }
+
+    return push_node(level, payload_bytes, slot_count, first_child, children.size());
+}
+
+OduHandle OduStore::import(const Odu& odu) {
+    if (!odu.is_aggregated()) {
+        // Bypass the nominal capacity check: the Odu already exists
+        return push_node(odu.level(), odu.payload_size(), odu.slots(), children_.size(), 0);
+    }
+
+    std::vector<ChildPlacement> placements;
+    placements.reserve(odu.groomed_children().size());
+
+    for (const auto& gc : odu.groomed_children()) {
+        placements.push_back({import(*gc.child), gc.slot_offset});
+    }
+
+    return add_aggregate(odu.level(), placements);
+}
+
+// ---------------- ACCESSORS ----------------
+
+OduStore::ChildRange OduStore::children(OduHandle h) const {
+    const StoredChild* base = children_.data() + first_child_[h.index];
+    return {base, base + child_count_[h.index]};
+}
+
+std::size_t OduStore::memory_bytes() const {
+    return level_.capacity() * sizeof(OduLevel) +
+           payload_bytes_.capacity() * sizeof(std::uint64_t) +
+           slot_count_.capacity() * sizeof(std::uint8_t) +
+           first_child_.capacity() * sizeof(std::uint32_t) +
+           child_count_.capacity() * sizeof(std::uint8_t) +
+           children_.capacity() * sizeof(StoredChild);
+}
+
+// ---------------- SNAPSHOT ----------------
+
+namespace {
+
+template <typename T>
+void write_section(std::ostream& out, std::uint64_t& pos, std::uint64_t offset,
+                   const std::vector<T>& values) {
+    static const char padding[8] = {};
+    out.write(padding, static_cast<std::streamsize>(offset - pos));
+    out.write(reinterpret_cast<const char*>(values.data()),
+              static_cast<std::streamsize>(values.size() * sizeof(T)));
+    pos = offset + values.size() * sizeof(T);
+}
+
+template <typename T>
+std::vector<T> copy_section(const T* first, std::size_t count) {
+    return std::vector<T>(first, first + count);
+}
+
+} // anonymous namespace
+
+void OduStore::save(std::ostream& out) const {
+    const SnapshotHeader header = snapshot_layout(size(), children_.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::uint64_t pos = sizeof(header);
+    write_section(out, pos, header.payload_bytes_offset, payload_bytes_);
+    write_section(out, pos, header.children_offset, children_);
+    write_section(out, pos, header.first_child_offset, first_child_);
+    write_section(out, pos, header.level_offset, level_);
+    write_section(out, pos, header.slot_count_offset, slot_count_);
+    write_section(out, pos, header.child_count_offset, child_count_);
+
+    static const char padding[8] = {};
+    out.write(padding, static_cast<std::streamsize>(header.file_bytes - pos));
+
+    if (!out) {
+        throw std::runtime_error("Failed to write ODU snapshot");
+    }
+}
+
+void OduStore::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open snapshot file: " + path);
+    }
+    save(out);
+    out.flush();
+    if (!out) {
+        throw std::runtime_error("Failed to write ODU snapshot");
+    }
+}
+
+OduStore OduStore::load(const MappedSnapshot& snapshot) {
+    // The mutable store indexes children unchecked, so the file must pass first
+    snapshot.verify();
+
+    const std::size_t n = snapshot.size();
+
+    OduStore store;
+    store.level_         = copy_section(snapshot.level_, n);
+    store.payload_bytes_ = copy_section(snapshot.payload_bytes_, n);
+    store.slot_count_    = copy_section(snapshot.slot_count_, n);
+    store.first_child_   = copy_section(snapshot.first_child_, n);
+    store.child_count_   = copy_section(snapshot.child_count_, n);
+    store.children_      = copy_section(snapshot.children_, snapshot.child_link_count());
+    return store;
+}
+
+OduStore OduStore::load(const std::string& path) {
+    return load(MappedSnapshot(path));
+}
+
+void OduStore::clear() {
+    level_.clear();
+    payload_bytes_.clear();
+    slot_count_.clear();
+    first_child_.clear();
+    child_count_.clear();
+    children_.clear();
+}
+
+} // namespace otn
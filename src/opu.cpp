@@ -10,4 +10,8 @@ size_t Opu::payload_size() const {
     return payload_.size();
 }
 
+const Payload& Opu::payload() const {
+    return payload_;
+}
+
 }
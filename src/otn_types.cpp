@@ -2,29 +2,16 @@
 
 namespace otn {
 
-size_t nominal_capacity(OduLevel level) {
-    switch (level) {
-        case OduLevel::ODU1:
-            return 2500;
-        case OduLevel::ODU2:
-            return 10000;
-        case OduLevel::ODU3:
-            return 40000;
-        case OduLevel::ODU4:
-            return 100000;
-        default:
-            return 0; // throws 0 if undefined OTN level
-    }
-}
-
-size_t tributary_slots(OduLevel level) {
-    switch (level) {
-        case OduLevel::ODU1: return 1;
-        case OduLevel::ODU2: return 4;
-        case OduLevel::ODU3: return 16;
-        case OduLevel::ODU4: return 80;
-        default: return 0;
+const char* to_string(GroomStatus status) {
+    switch (status) {
+        case GroomStatus::OK:                 return "OK";
+        case GroomStatus::MIXED_CHILD_LEVELS: return "Mixed child ODU levels";
+        case GroomStatus::INVALID_HIERARCHY:  return "Invalid ODU level hierarchy";
+        case GroomStatus::INSUFFICIENT_SLOTS: return "Insufficient tributary slots";
+        case GroomStatus::SLOT_OUT_OF_RANGE:  return "Child exceeds parent slot range";
+        case GroomStatus::OVERLAPPING_SLOTS:  return "Overlapping tributary slots";
     }
+    return "Unknown grooming status";
 }
 
 } // namespace otn
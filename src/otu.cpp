@@ -1,21 +1,34 @@
 #include "otn/otu.hpp"
+#include <stdexcept>
 
 namespace otn {
 
 Otu::Otu(const Odu& odu, bool fec_enabled)
-    : odu_(odu), fec_enabled_(fec_enabled)
+    : odu_(std::make_shared<const Odu>(odu)), fec_enabled_(fec_enabled)
 {}
 
+Otu::Otu(std::shared_ptr<const Odu> odu, bool fec_enabled)
+    : odu_(std::move(odu)), fec_enabled_(fec_enabled)
+{
+    if (!odu_) {
+        throw std::runtime_error("OTU requires an ODU");
+    }
+}
+
 bool Otu::fec_enabled() const {
     return fec_enabled_;
 }
 
 OduLevel Otu::odu_level() const {
-    return odu_.level();
+    return odu_->level();
 }
 
 size_t Otu::payload_size() const {
-    return odu_.payload_size();
+    return odu_->payload_size();
+}
+
+const Odu& Otu::odu() const {
+    return *odu_;
 }
 
 } // namespace otn
@@ -0,0 +1,129 @@
+#include "otn/parallel.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace otn {
+
+namespace {
+
+// Half-open index block owned by one worker; padded to avoid false sharing
+struct alignas(64) WorkRange {
+    std::mutex lock;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+};
+
+// Owner side: take the next index from the front
+bool pop_front(WorkRange& range, std::size_t& index) {
+    std::lock_guard<std::mutex> guard(range.lock);
+    if (range.begin == range.end) return false;
+    index = range.begin++;
+    return true;
+}
+
+// Thief side: take the back half of a victim's remaining block
+bool steal_back(WorkRange& victim, std::size_t& begin, std::size_t& end) {
+    std::lock_guard<std::mutex> guard(victim.lock);
+    const std::size_t remaining = victim.end - victim.begin;
+    if (remaining == 0) return false;
+
+    const std::size_t take = (remaining + 1) / 2;
+    end = victim.end;
+    begin = victim.end - take;
+    victim.end = begin;
+    return true;
+}
+
+} // anonymous namespace
+
+std::size_t resolve_thread_count(std::size_t requested, std::size_t count) {
+    std::size_t threads = requested;
+    if (threads == 0) {
+        threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    return std::max<std::size_t>(1, std::min(threads, count));
+}
+
+void parallel_for(
+    std::size_t count,
+    std::size_t threads,
+    const std::function<void(std::size_t)>& task
+) {
+    if (count == 0) return;
+
+    const std::size_t workers = resolve_thread_count(threads, count);
+
+    std::mutex error_lock;
+    std::exception_ptr first_error;
+    std::size_t first_error_index = count;
+
+    auto run_one = [&](std::size_t index) {
+        try {
+            task(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(error_lock);
+            if (index < first_error_index) {
+                first_error_index = index;
+                first_error = std::current_exception();
+            }
+        }
+    };
+
+    if (workers == 1) {
+        for (std::size_t i = 0; i < count; ++i) run_one(i);
+    } else {
+        std::unique_ptr<WorkRange[]> ranges(new WorkRange[workers]);
+
+        // Deal out contiguous blocks up front
+        for (std::size_t w = 0; w < workers; ++w) {
+            ranges[w].begin = count * w / workers;
+            ranges[w].end   = count * (w + 1) / workers;
+        }
+
+        auto worker = [&](std::size_t self) {
+            for (;;) {
+                std::size_t index;
+                while (pop_front(ranges[self], index)) {
+                    run_one(index);
+                }
+
+                // Own block drained: scan the others for work to steal
+                bool stole = false;
+                for (std::size_t k = 1; k < workers && !stole; ++k) {
+                    std::size_t begin, end;
+                    if (steal_back(ranges[(self + k) % workers], begin, end)) {
+                        std::lock_guard<std::mutex> guard(ranges[self].lock);
+                        ranges[self].begin = begin;
+                        ranges[self].end   = end;
+                        stole = true;
+                    }
+                }
+
+                // A range only shrinks while its owner holds it and is replaced
+                // only by that owner's steal, so work this scan missed already
+                // belongs to a worker that will run it; nothing is left for us
+                if (!stole) return;
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        for (std::size_t w = 1; w < workers; ++w) {
+            pool.emplace_back(worker, w);
+        }
+        worker(0);
+
+        for (auto& t : pool) t.join();
+    }
+
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+}
+
+} // namespace otn
@@ -4,11 +4,32 @@
 namespace otn {
 
 Payload::Payload(size_t size)
-    : data_(size, 0)
+    : size_(size)
 {}
 
+Payload::Payload(Buffer bytes)
+    : size_(bytes ? bytes->size() : 0),
+      bytes_(std::move(bytes))
+{}
+
+Payload Payload::zero_filled(size_t size) {
+    return Payload(std::make_shared<const std::vector<uint8_t>>(size, 0));
+}
+
 size_t Payload::size() const {
-    return data_.size();
+    return size_;
+}
+
+bool Payload::has_bytes() const {
+    return bytes_ != nullptr;
+}
+
+const uint8_t* Payload::data() const {
+    return bytes_ ? bytes_->data() : nullptr;
+}
+
+const Payload::Buffer& Payload::buffer() const {
+    return bytes_;
 }
 
 }
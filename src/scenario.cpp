@@ -0,0 +1,449 @@
+#include "otn/scenario.hpp"
+#include "otn/fragmentation.hpp"
+#include "otn/parallel.hpp"
+#include "otn/topology.hpp"
+#include "otn/trace.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace otn {
+
+namespace {
+
+std::string trim(const std::string& s) {
+    const auto first = s.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    const auto last = s.find_last_not_of(" \t\r");
+    return s.substr(first, last - first + 1);
+}
+
+std::vector<std::string> split(const std::string& s, char sep) {
+    std::vector<std::string> parts;
+    std::stringstream in(s);
+    std::string part;
+    while (std::getline(in, part, sep)) {
+        part = trim(part);
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+double parse_double(const std::string& key, const std::string& value) {
+    std::size_t used = 0;
+    double v = 0.0;
+    try {
+        v = std::stod(value, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != value.size()) {
+        throw std::runtime_error("Bad number for " + key + ": " + value);
+    }
+    return v;
+}
+
+uint64_t parse_count(const std::string& key, const std::string& value) {
+    std::size_t used = 0;
+    unsigned long long v = 0;
+    try {
+        if (!value.empty() && value[0] != '-') v = std::stoull(value, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != value.size()) {
+        throw std::runtime_error("Bad count for " + key + ": " + value);
+    }
+    return v;
+}
+
+OduLevel parse_level(std::string token) {
+    if (token.size() > 3) {
+        const std::string prefix = token.substr(0, 3);
+        if (prefix == "ODU" || prefix == "odu") {
+            token = token.substr(3);
+        }
+    }
+
+    if (token == "1") return OduLevel::ODU1;
+    if (token == "2") return OduLevel::ODU2;
+    if (token == "3") return OduLevel::ODU3;
+    if (token == "4") return OduLevel::ODU4;
+
+    throw std::runtime_error("Unknown ODU level: " + token);
+}
+
+std::vector<DemandClass> parse_demand_mix(const std::string& value) {
+    std::vector<DemandClass> mix;
+    for (const std::string& entry : split(value, ',')) {
+        const auto colon = entry.find(':');
+        if (colon == std::string::npos) {
+            throw std::runtime_error("Demand mix entries are LEVEL:WEIGHT, got: " + entry);
+        }
+        const double weight = parse_double("demand_mix", trim(entry.substr(colon + 1)));
+        if (!(weight > 0.0)) {
+            throw std::runtime_error("Demand mix weights must be positive");
+        }
+        mix.push_back({parse_level(trim(entry.substr(0, colon))), weight});
+    }
+    if (mix.empty()) {
+        throw std::runtime_error("Demand mix is empty");
+    }
+    return mix;
+}
+
+// Named overrides of the default weights, e.g. "gap_count:1, max_gap:0"
+FragmentationCostWeights parse_cost_weights(const std::string& value) {
+    FragmentationCostWeights weights;
+    for (const std::string& entry : split(value, ',')) {
+        const auto colon = entry.find(':');
+        if (colon == std::string::npos) {
+            throw std::runtime_error("Cost weight entries are NAME:WEIGHT, got: " + entry);
+        }
+        const std::string name = trim(entry.substr(0, colon));
+        const double weight = parse_double("cost_weights", trim(entry.substr(colon + 1)));
+
+        if (name == "utilization")      weights.utilization_weight = weight;
+        else if (name == "gap_count")   weights.gap_count_weight = weight;
+        else if (name == "gap_slots")   weights.gap_slots_weight = weight;
+        else if (name == "max_gap")     weights.max_gap_weight = weight;
+        else throw std::runtime_error("Unknown cost weight: " + name);
+    }
+    return weights;
+}
+
+std::string resolve(const std::string& path, const std::string& base_dir) {
+    if (base_dir.empty() || std::filesystem::path(path).is_absolute()) return path;
+    return (std::filesystem::path(base_dir) / path).string();
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ---------------- MODES ----------------
+
+void run_simulate(const Scenario& s, ScenarioReport& r) {
+    const SimulationStats stats = Simulator(s.sim).run();
+
+    r.operations = stats.events;
+    r.blocking = stats.blocking_probability;
+    r.mean_utilization = stats.mean_utilization;
+    r.mean_fragmentation = stats.mean_fragmentation_cost;
+    r.final_fragmentation = stats.final_fragmentation_cost;
+    r.repacks = stats.repacks;
+    r.repack_admissions = stats.repack_admissions;
+}
+
+void run_sweep(const Scenario& s, ScenarioReport& r) {
+    MonteCarloConfig config;
+    config.base = s.sim;
+    config.loads = s.loads;
+    config.replications = s.replications;
+    config.base_seed = s.sim.seed;
+    config.threads = s.threads;
+
+    MonteCarloResult result = run_monte_carlo(config);
+
+    uint64_t arrivals = 0, blocked = 0;
+    for (const LoadPointResult& p : result.points) {
+        for (std::size_t l = 0; l < p.arrivals_per_level.size(); ++l) {
+            arrivals += p.arrivals_per_level[l];
+            blocked += p.blocked_per_level[l];
+        }
+        r.mean_utilization += p.utilization.mean;
+        r.mean_fragmentation += p.fragmentation_cost.mean;
+    }
+
+    const double points = static_cast<double>(result.points.size());
+    r.operations = result.total_events;
+    r.blocking = arrivals ? static_cast<double>(blocked) / static_cast<double>(arrivals) : 0.0;
+    r.mean_utilization /= points;
+    r.mean_fragmentation /= points;
+    r.points = std::move(result.points);
+}
+
+void run_replay(const Scenario& s, ScenarioReport& r) {
+    if (s.trace.empty()) {
+        throw std::runtime_error("Replay scenario needs a trace");
+    }
+
+    ReplayConfig config;
+    config.parent_level = s.sim.parent_level;
+    config.parent_count = s.sim.parent_count;
+    config.policy = s.sim.policy;
+    config.cost_weights = s.sim.cost_weights;
+
+    TraceReader reader(s.trace);
+    const ReplayStats stats = replay_trace(reader, config);
+
+    r.operations = stats.records;
+    r.operation_unit = "records";
+    r.blocking = stats.blocking_probability;
+    r.mean_utilization = stats.mean_utilization;
+    r.final_fragmentation = stats.final_fragmentation_cost;
+}
+
+void run_route(const Scenario& s, ScenarioReport& r) {
+    if (s.topology.empty()) {
+        throw std::runtime_error("Route scenario needs a topology");
+    }
+
+    Topology topology = Topology::from_edge_list_file(s.topology);
+    if (topology.node_count() < 2) {
+        throw std::runtime_error("Route scenario needs at least two nodes");
+    }
+    Router router(topology, s.k_paths);
+
+    std::mt19937_64 rng(s.sim.seed);
+    std::uniform_int_distribution<NodeId> pick_node(0, static_cast<NodeId>(topology.node_count() - 1));
+    std::vector<double> weights;
+    for (const auto& c : s.sim.demand_mix) weights.push_back(c.weight);
+    std::discrete_distribution<std::size_t> pick_class(weights.begin(), weights.end());
+
+    uint64_t blocked = 0;
+    for (std::size_t i = 0; i < s.route_demands; ++i) {
+        const NodeId src = pick_node(rng);
+        NodeId dst = pick_node(rng);
+        while (dst == src) dst = pick_node(rng);
+        const OduLevel level = s.sim.demand_mix[pick_class(rng)].level;
+
+        if (!router.route_and_reserve(src, dst, level)) ++blocked;
+    }
+
+    std::size_t used = 0, capacity = 0;
+    double cost = 0.0;
+    for (LinkId id = 0; id < topology.link_count(); ++id) {
+        const SlotMap& occupancy = topology.link(id).occupancy;
+        used += occupancy.count();
+        capacity += occupancy.capacity();
+        cost += fragmentation_cost(analyze_fragmentation(occupancy));
+    }
+
+    r.operations = s.route_demands;
+    r.operation_unit = "demands";
+    r.blocking = s.route_demands
+        ? static_cast<double>(blocked) / static_cast<double>(s.route_demands)
+        : 0.0;
+    r.mean_utilization = capacity ? static_cast<double>(used) / static_cast<double>(capacity) : 0.0;
+    r.final_fragmentation = topology.link_count()
+        ? cost / static_cast<double>(topology.link_count())
+        : 0.0;
+}
+
+} // anonymous namespace
+
+// ---------------- PARSING ----------------
+
+void apply_scenario_setting(
+    Scenario& s,
+    const std::string& key,
+    const std::string& value,
+    const std::string& base_dir
+) {
+    if (key == "mode") {
+        if (value == "simulate")      s.mode = ScenarioMode::SIMULATE;
+        else if (value == "sweep")    s.mode = ScenarioMode::SWEEP;
+        else if (value == "replay")   s.mode = ScenarioMode::REPLAY;
+        else if (value == "route")    s.mode = ScenarioMode::ROUTE;
+        else throw std::runtime_error("Unknown mode: " + value);
+    } else if (key == "parent_level") {
+        s.sim.parent_level = parse_level(value);
+        if (s.mode != ScenarioMode::ROUTE) check_demand_mix(s.sim.parent_level, s.sim.demand_mix);
+    } else if (key == "parents") {
+        s.sim.parent_count = parse_count(key, value);
+    } else if (key == "demand_mix") {
+        s.sim.demand_mix = parse_demand_mix(value);
+        // Route demands go onto links of any level, not into parents
+        if (s.mode != ScenarioMode::ROUTE) check_demand_mix(s.sim.parent_level, s.sim.demand_mix);
+    } else if (key == "policy") {
+        s.sim.policy = parse_cost_policy(value);
+    } else if (key == "cost_weights") {
+        s.sim.cost_weights = parse_cost_weights(value);
+        s.sim.repack_budget.weights = s.sim.cost_weights;
+    } else if (key == "repack") {
+        if (value == "none")                s.sim.repack = SimRepackPolicy::NONE;
+        else if (value == "size_aware")     s.sim.repack = SimRepackPolicy::SIZE_AWARE;
+        else if (value == "deterministic")  s.sim.repack = SimRepackPolicy::DETERMINISTIC;
+        else if (value == "optimal")        s.sim.repack = SimRepackPolicy::OPTIMAL;
+        else throw std::runtime_error("Unknown repack policy: " + value);
+    } else if (key == "repack_max_nodes") {
+        s.sim.repack_budget.max_nodes = parse_count(key, value);
+    } else if (key == "arrival_rate") {
+        s.sim.arrival_rate = parse_double(key, value);
+    } else if (key == "holding_time") {
+        s.sim.mean_holding_time = parse_double(key, value);
+    } else if (key == "arrivals") {
+        s.sim.arrivals = parse_count(key, value);
+    } else if (key == "warmup") {
+        s.sim.warmup_arrivals = parse_count(key, value);
+    } else if (key == "seed") {
+        s.sim.seed = parse_count(key, value);
+    } else if (key == "threads") {
+        s.threads = parse_count(key, value);
+    } else if (key == "loads") {
+        s.loads.clear();
+        for (const std::string& load : split(value, ',')) {
+            s.loads.push_back(parse_double(key, load));
+        }
+        if (s.loads.empty()) {
+            throw std::runtime_error("Load list is empty");
+        }
+    } else if (key == "replications") {
+        s.replications = parse_count(key, value);
+    } else if (key == "trace") {
+        s.trace = resolve(value, base_dir);
+    } else if (key == "topology") {
+        s.topology = resolve(value, base_dir);
+    } else if (key == "demands") {
+        s.route_demands = parse_count(key, value);
+    } else if (key == "k_paths") {
+        s.k_paths = parse_count(key, value);
+    } else {
+        throw std::runtime_error("Unknown scenario key: " + key);
+    }
+}
+
+Scenario parse_scenario(std::istream& in, const std::string& base_dir) {
+    Scenario s;
+    std::string line;
+    std::size_t line_no = 0;
+
+    while (std::getline(in, line)) {
+        ++line_no;
+        const auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        const auto eq = line.find('=');
+        if (eq == std::string::npos) {
+            throw std::runtime_error("Scenario line " + std::to_string(line_no) + ": expected key = value");
+        }
+
+        try {
+            apply_scenario_setting(s, trim(line.substr(0, eq)), trim(line.substr(eq + 1)), base_dir);
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Scenario line " + std::to_string(line_no) + ": " + e.what());
+        }
+    }
+    return s;
+}
+
+Scenario load_scenario(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open scenario file: " + path);
+    }
+    return parse_scenario(in, std::filesystem::path(path).parent_path().string());
+}
+
+const char* to_string(ScenarioMode mode) {
+    switch (mode) {
+        case ScenarioMode::SIMULATE: return "simulate";
+        case ScenarioMode::SWEEP:    return "sweep";
+        case ScenarioMode::REPLAY:   return "replay";
+        case ScenarioMode::ROUTE:    return "route";
+    }
+    return "unknown";
+}
+
+const char* to_string(SimRepackPolicy policy) {
+    switch (policy) {
+        case SimRepackPolicy::NONE:          return "none";
+        case SimRepackPolicy::SIZE_AWARE:    return "size_aware";
+        case SimRepackPolicy::DETERMINISTIC: return "deterministic";
+        case SimRepackPolicy::OPTIMAL:       return "optimal";
+    }
+    return "unknown";
+}
+
+// ---------------- RUNNING ----------------
+
+ScenarioReport run_scenario(const Scenario& scenario) {
+    ScenarioReport report;
+    const auto start = std::chrono::steady_clock::now();
+
+    switch (scenario.mode) {
+        case ScenarioMode::SIMULATE: run_simulate(scenario, report); break;
+        case ScenarioMode::SWEEP:    run_sweep(scenario, report);    break;
+        case ScenarioMode::REPLAY:   run_replay(scenario, report);   break;
+        case ScenarioMode::ROUTE:    run_route(scenario, report);    break;
+    }
+
+    report.wall_seconds = seconds_since(start);
+    return report;
+}
+
+void print_report(std::ostream& out, const Scenario& s, const ScenarioReport& r) {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+
+    out << "Mode:          " << to_string(s.mode) << "\n";
+    if (s.mode == ScenarioMode::ROUTE) {
+        out << "Topology:      " << s.topology << " (k = " << s.k_paths << ")\n";
+    } else {
+        out << "Parents:       " << s.sim.parent_count << " x ODU"
+            << static_cast<int>(s.sim.parent_level) << "\n";
+    }
+    out << "Demand mix:   ";
+    for (const auto& c : s.sim.demand_mix) {
+        out << " ODU" << static_cast<int>(c.level) << ":" << c.weight;
+    }
+    out << "\n";
+    if (s.mode != ScenarioMode::ROUTE) {
+        out << "Policy:        " << to_string(s.sim.policy);
+        if (s.mode != ScenarioMode::REPLAY) out << " (repack: " << to_string(s.sim.repack) << ")";
+        out << "\n";
+    }
+    out << "Seed:          " << s.sim.seed << "\n";
+    if (s.mode == ScenarioMode::SWEEP) {
+        out << "Threads:       " << resolve_thread_count(s.threads, s.loads.size() * s.replications) << "\n";
+    }
+
+    out << std::fixed << std::setprecision(3);
+    out << "Wall time:     " << r.wall_seconds << " s\n";
+    out << std::setprecision(0);
+    out << "Operations:    " << r.operations << " " << r.operation_unit
+        << " (" << r.operations_per_second() << " ops/s)\n";
+    out << std::setprecision(5);
+    out << "Blocking:      " << r.blocking << "\n";
+    out << "Utilization:   " << r.mean_utilization
+        << (s.mode == ScenarioMode::ROUTE ? " (final)" : " (time-averaged)") << "\n";
+
+    out << "Fragmentation:";
+    if (s.mode != ScenarioMode::SWEEP) out << " " << r.final_fragmentation << " final";
+    if (s.mode == ScenarioMode::SIMULATE || s.mode == ScenarioMode::SWEEP) {
+        out << (s.mode == ScenarioMode::SIMULATE ? "," : "") << " "
+            << r.mean_fragmentation << " time-averaged";
+    }
+    out << "\n";
+
+    if (s.mode == ScenarioMode::SIMULATE && s.sim.repack != SimRepackPolicy::NONE) {
+        out << "Repacks:       " << r.repacks << " (" << r.repack_admissions
+            << " arrivals admitted after repack)\n";
+    }
+
+    if (!r.points.empty()) {
+        out << "\n" << std::setw(10) << "load" << std::setw(12) << "blocking"
+            << std::setw(12) << "+/- 95%" << std::setw(13) << "utilization"
+            << std::setw(15) << "fragmentation" << "\n";
+        for (const LoadPointResult& p : r.points) {
+            out << std::setprecision(1) << std::setw(10) << p.offered_load
+                << std::setprecision(5) << std::setw(12) << p.blocking.mean
+                << std::setw(12) << p.blocking.ci_half_width
+                << std::setw(13) << p.utilization.mean
+                << std::setw(15) << p.fragmentation_cost.mean << "\n";
+        }
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} // namespace otn
@@ -0,0 +1,304 @@
+#include "otn/simulation.hpp"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace otn {
+
+// ---------------- EVENT QUEUE ----------------
+
+namespace {
+
+bool later(const Event& a, const Event& b) {
+    if (a.time != b.time) return a.time > b.time;
+    return a.sequence > b.sequence;
+}
+
+} // anonymous namespace
+
+void EventQueue::reserve(std::size_t events) {
+    heap_.reserve(events);
+}
+
+void EventQueue::push(double time, EventType type, uint32_t demand) {
+    heap_.push_back({time, next_sequence_++, type, demand});
+    std::push_heap(heap_.begin(), heap_.end(), later);
+}
+
+Event EventQueue::pop() {
+    std::pop_heap(heap_.begin(), heap_.end(), later);
+    const Event e = heap_.back();
+    heap_.pop_back();
+    return e;
+}
+
+void EventQueue::clear() {
+    heap_.clear();
+    next_sequence_ = 0;
+}
+
+// ---------------- SIMULATOR ----------------
+
+void check_demand_mix(OduLevel parent_level, const std::vector<DemandClass>& mix) {
+    for (const DemandClass& c : mix) {
+        if (c.level >= parent_level) {
+            throw std::runtime_error(
+                "ODU" + std::to_string(static_cast<int>(c.level)) +
+                " demands cannot be groomed into ODU" +
+                std::to_string(static_cast<int>(parent_level)) + " parents"
+            );
+        }
+    }
+}
+
+Simulator::Simulator(SimulationConfig config)
+    : config_(std::move(config))
+{
+    if (config_.parent_count == 0) {
+        throw std::runtime_error("Simulation needs at least one parent ODU");
+    }
+    if (config_.demand_mix.empty()) {
+        throw std::runtime_error("Simulation needs a demand mix");
+    }
+    check_demand_mix(config_.parent_level, config_.demand_mix);
+    if (config_.arrival_rate <= 0.0 || config_.mean_holding_time <= 0.0) {
+        throw std::runtime_error("Arrival rate and holding time must be positive");
+    }
+}
+
+uint32_t Simulator::allocate_demand() {
+    if (!free_demands_.empty()) {
+        const uint32_t id = free_demands_.back();
+        free_demands_.pop_back();
+        return id;
+    }
+    demands_.push_back({});
+    return static_cast<uint32_t>(demands_.size() - 1);
+}
+
+void Simulator::advance_clock(double now) {
+    if (measuring_) {
+        const double dt = now - clock_;
+        const double capacity =
+            static_cast<double>(tributary_slots(config_.parent_level)) *
+            static_cast<double>(parents_.size());
+
+        utilization_area_ += dt * static_cast<double>(occupied_slots_) / capacity;
+        cost_area_ += dt * total_cost_ / static_cast<double>(parents_.size());
+    }
+    clock_ = now;
+}
+
+void Simulator::update_cost(uint32_t p) {
+    const double cost = fragmentation_cost(parents_[p].fragmentation().metrics());
+    total_cost_ += cost - parent_cost_[p];
+    parent_cost_[p] = cost;
+}
+
+bool Simulator::place(uint32_t p, Demand& demand) {
+    const Odu& child = prototypes_[static_cast<OduLevel>(demand.level)];
+    AdmissionEngine& engine = parents_[p];
+
+    const AdmissionResult r = dispatch_cost_policy(
+        config_.policy, config_.cost_weights,
+        [&](const auto& policy) { return engine.best_placement(child, policy); }
+    );
+    if (!r.admitted) return false;
+    const std::size_t offset = r.chosen_offset;
+
+    engine.commit(&child, offset);
+
+    demand.parent = p;
+    demand.offset = static_cast<uint16_t>(offset);
+    demand.width  = static_cast<uint16_t>(child.slots());
+    demand.active = true;
+
+    update_cost(p);
+    occupied_slots_ += demand.width;
+    return true;
+}
+
+void Simulator::repack(uint32_t p) {
+    repack_in_.clear();
+    for (auto& ids : repack_ids_) ids.clear();
+
+    for (uint32_t id = 0; id < demands_.size(); ++id) {
+        const Demand& d = demands_[id];
+        if (!d.active || d.parent != p) continue;
+        repack_in_.emplace_back(&prototypes_[static_cast<OduLevel>(d.level)], d.width, d.offset);
+        repack_ids_[d.level].push_back(id);
+    }
+
+    GroomStatus status = GroomStatus::OK;
+    switch (config_.repack) {
+        case SimRepackPolicy::NONE:
+            return;
+        case SimRepackPolicy::SIZE_AWARE:
+            status = try_repack_grooming_size_aware(config_.parent_level, repack_in_, repack_out_);
+            break;
+        case SimRepackPolicy::DETERMINISTIC:
+            status = try_repack_grooming_deterministic(config_.parent_level, repack_in_, repack_out_);
+            break;
+        case SimRepackPolicy::OPTIMAL: {
+            RepackReport report;
+            status = try_repack_grooming_optimal(
+                config_.parent_level, repack_in_, report, config_.repack_budget
+            );
+            repack_out_ = std::move(report.grooming);
+            break;
+        }
+    }
+    // The current layout is itself a packing, so this only guards the invariant
+    if (status != GroomStatus::OK) return;
+
+    // Same-level demands are interchangeable: hand out the new offsets by level
+    for (const GroomedChild& g : repack_out_) {
+        auto& ids = repack_ids_[static_cast<uint8_t>(g.child->level())];
+        demands_[ids.back()].offset = static_cast<uint16_t>(g.slot_offset);
+        ids.pop_back();
+    }
+
+    parents_[p] = AdmissionEngine(config_.parent_level, repack_out_, cost_policy_picks(config_.policy));
+    update_cost(p);
+    if (measuring_) ++repacks_;
+}
+
+bool Simulator::admit(Demand& demand) {
+    for (uint32_t p = 0; p < parents_.size(); ++p) {
+        if (place(p, demand)) return true;
+    }
+
+    if (config_.repack == SimRepackPolicy::NONE) return false;
+
+    const std::size_t width = prototypes_[static_cast<OduLevel>(demand.level)].slots();
+    const std::size_t capacity = tributary_slots(config_.parent_level);
+
+    for (uint32_t p = 0; p < parents_.size(); ++p) {
+        // Repacking cannot create slots that are not free
+        if (capacity - parents_[p].occupancy().count() < width) continue;
+
+        repack(p);
+        if (place(p, demand)) {
+            if (measuring_) ++repack_admissions_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Simulator::release(Demand& demand) {
+    parents_[demand.parent].release(demand.offset, demand.width);
+    demand.active = false;
+
+    update_cost(demand.parent);
+    occupied_slots_ -= demand.width;
+}
+
+SimulationStats Simulator::run() {
+    parents_.assign(
+        config_.parent_count,
+        AdmissionEngine(config_.parent_level, {}, cost_policy_picks(config_.policy))
+    );
+    parent_cost_.assign(config_.parent_count, 0.0);
+    total_cost_ = 0.0;
+    occupied_slots_ = 0;
+    demands_.clear();
+    free_demands_.clear();
+    queue_.clear();
+    repacks_ = 0;
+    repack_admissions_ = 0;
+
+    measuring_ = config_.warmup_arrivals == 0;
+    clock_ = 0.0;
+    measure_start_ = 0.0;
+    utilization_area_ = 0.0;
+    cost_area_ = 0.0;
+
+    std::mt19937_64 rng(config_.seed);
+    std::exponential_distribution<double> interarrival(config_.arrival_rate);
+    std::exponential_distribution<double> holding(1.0 / config_.mean_holding_time);
+
+    std::vector<double> weights;
+    for (const auto& c : config_.demand_mix) weights.push_back(c.weight);
+    std::discrete_distribution<std::size_t> pick_class(weights.begin(), weights.end());
+
+    SimulationStats stats;
+
+    const uint64_t total_arrivals = config_.warmup_arrivals + config_.arrivals;
+    uint64_t scheduled = 0;
+
+    auto schedule_arrival = [&](double now) {
+        if (scheduled == total_arrivals) return;
+        ++scheduled;
+        const uint32_t id = allocate_demand();
+        const OduLevel level = config_.demand_mix[pick_class(rng)].level;
+        demands_[id].level = static_cast<uint8_t>(level);
+        demands_[id].active = false;
+        queue_.push(now + interarrival(rng), EventType::ARRIVAL, id);
+    };
+
+    schedule_arrival(0.0);
+
+    uint64_t processed_arrivals = 0;
+
+    while (!queue_.empty()) {
+        const Event e = queue_.pop();
+        advance_clock(e.time);
+        ++stats.events;
+
+        if (e.type == EventType::DEPARTURE) {
+            release(demands_[e.demand]);
+            free_demands_.push_back(e.demand);
+            if (measuring_) ++stats.departures;
+            continue;
+        }
+
+        // Arrival: keep the Poisson stream going, then try to place it
+        schedule_arrival(e.time);
+
+        Demand& demand = demands_[e.demand];
+        const uint8_t level = demand.level;
+        const bool admitted = admit(demand);
+
+        if (measuring_) {
+            ++stats.arrivals;
+            ++stats.arrivals_per_level[level];
+            if (!admitted) {
+                ++stats.blocked;
+                ++stats.blocked_per_level[level];
+            }
+        }
+
+        if (admitted) {
+            queue_.push(e.time + holding(rng), EventType::DEPARTURE, e.demand);
+        } else {
+            free_demands_.push_back(e.demand);
+        }
+
+        ++processed_arrivals;
+        if (processed_arrivals == config_.warmup_arrivals && !measuring_) {
+            measuring_ = true;
+            measure_start_ = e.time;
+        }
+        if (processed_arrivals == total_arrivals) break;
+    }
+
+    stats.simulated_time = clock_ - measure_start_;
+    if (stats.arrivals > 0) {
+        stats.blocking_probability =
+            static_cast<double>(stats.blocked) / static_cast<double>(stats.arrivals);
+    }
+    if (stats.simulated_time > 0.0) {
+        stats.mean_utilization = utilization_area_ / stats.simulated_time;
+        stats.mean_fragmentation_cost = cost_area_ / stats.simulated_time;
+    }
+    stats.final_fragmentation_cost = total_cost_ / static_cast<double>(parents_.size());
+    stats.repacks = repacks_;
+    stats.repack_admissions = repack_admissions_;
+
+    return stats;
+}
+
+} // namespace otn
@@ -0,0 +1,242 @@
+#include "otn/slot_map.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace otn {
+
+namespace {
+
+constexpr std::uint64_t kAllOnes = ~std::uint64_t{0};
+
+// Mask covering bits [lo, hi) of a single word, 0 <= lo <= hi <= 64
+std::uint64_t word_mask(std::size_t lo, std::size_t hi) {
+    if (lo >= hi) return 0;
+    const std::uint64_t upper =
+        hi >= SlotMap::kWordBits ? kAllOnes : ((std::uint64_t{1} << hi) - 1);
+    const std::uint64_t lower = (std::uint64_t{1} << lo) - 1;
+    return upper & ~lower;
+}
+
+// Bits of word w covered by [offset, offset + width)
+std::uint64_t range_word(std::size_t w, std::size_t offset, std::size_t width) {
+    const std::size_t base = w * SlotMap::kWordBits;
+    const std::size_t end  = offset + width;
+
+    if (end <= base || offset >= base + SlotMap::kWordBits) return 0;
+
+    const std::size_t lo = offset > base ? offset - base : 0;
+    const std::size_t hi =
+        end - base >= SlotMap::kWordBits ? SlotMap::kWordBits : end - base;
+    return word_mask(lo, hi);
+}
+
+// words >> shift, treating the array as one little-endian integer
+SlotMap::Words shift_right(const SlotMap::Words& in, std::size_t shift) {
+    SlotMap::Words out{};
+    const std::size_t word_shift = shift / SlotMap::kWordBits;
+    const std::size_t bit_shift  = shift % SlotMap::kWordBits;
+
+    for (std::size_t w = 0; w + word_shift < SlotMap::kWords; ++w) {
+        std::uint64_t v = in[w + word_shift] >> bit_shift;
+        if (bit_shift != 0 && w + word_shift + 1 < SlotMap::kWords) {
+            v |= in[w + word_shift + 1] << (SlotMap::kWordBits - bit_shift);
+        }
+        out[w] = v;
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+SlotMap::SlotMap(std::size_t capacity)
+    : words_{},
+      capacity_(capacity)
+{
+    if (capacity > kMaxSlots) {
+        throw std::runtime_error("SlotMap capacity exceeds supported slot count");
+    }
+}
+
+SlotMap SlotMap::from_words(std::size_t capacity, const Words& words) {
+    SlotMap result(capacity);
+    for (std::size_t w = 0; w < kWords; ++w) {
+        result.words_[w] = words[w] & range_word(w, 0, capacity);
+    }
+    return result;
+}
+
+std::size_t SlotMap::count() const {
+    std::size_t n = 0;
+    for (std::uint64_t w : words_) {
+        n += static_cast<std::size_t>(__builtin_popcountll(w));
+    }
+    return n;
+}
+
+std::size_t SlotMap::count_range(std::size_t offset, std::size_t width) const {
+    std::size_t n = 0;
+    for (std::size_t w = 0; w < kWords; ++w) {
+        n += static_cast<std::size_t>(
+            __builtin_popcountll(words_[w] & range_word(w, offset, width))
+        );
+    }
+    return n;
+}
+
+bool SlotMap::none() const {
+    for (std::uint64_t w : words_) {
+        if (w != 0) return false;
+    }
+    return true;
+}
+
+bool SlotMap::test(std::size_t slot) const {
+    if (slot >= capacity_) return false;
+    return (words_[slot / kWordBits] >> (slot % kWordBits)) & 1u;
+}
+
+bool SlotMap::range_free(std::size_t offset, std::size_t width) const {
+    if (offset > capacity_ || width > capacity_ - offset) return false;
+
+    for (std::size_t w = 0; w < kWords; ++w) {
+        if (words_[w] & range_word(w, offset, width)) return false;
+    }
+    return true;
+}
+
+void SlotMap::set_range(std::size_t offset, std::size_t width) {
+    for (std::size_t w = 0; w < kWords; ++w) {
+        words_[w] |= range_word(w, offset, width);
+    }
+}
+
+void SlotMap::clear_range(std::size_t offset, std::size_t width) {
+    for (std::size_t w = 0; w < kWords; ++w) {
+        words_[w] &= ~range_word(w, offset, width);
+    }
+}
+
+bool SlotMap::overlaps(const SlotMap& other) const {
+    for (std::size_t w = 0; w < kWords; ++w) {
+        if (words_[w] & other.words_[w]) return true;
+    }
+    return false;
+}
+
+SlotMap SlotMap::complement() const {
+    SlotMap result(capacity_);
+    for (std::size_t w = 0; w < kWords; ++w) {
+        result.words_[w] = ~words_[w] & range_word(w, 0, capacity_);
+    }
+    return result;
+}
+
+SlotMap SlotMap::fit_mask(std::size_t width) const {
+    if (width == 0 || width > capacity_) return SlotMap(capacity_);
+
+    // Free slots are exactly the starts of free runs of length 1
+    return complement().extend_runs(1, width);
+}
+
+SlotMap SlotMap::extend_runs(std::size_t run, std::size_t width) const {
+    SlotMap result(capacity_);
+    if (run == 0 || width < run || width > capacity_) return result;
+
+    // Bit i survives iff bits i..i+width-1 are all free; bits past
+    // capacity are zero so runs that overhang the end drop out.
+    // Log-step doubling: after each step fits marks runs of length `run`,
+    // so width needs ~log2(width / run) shift-ANDs instead of width - run
+    Words fits = words_;
+    while (run < width) {
+        const std::size_t step = std::min(run, width - run);
+        const Words shifted = shift_right(fits, step);
+        for (std::size_t w = 0; w < kWords; ++w) {
+            fits[w] &= shifted[w];
+        }
+        run += step;
+    }
+
+    result.words_ = fits;
+    return result;
+}
+
+std::size_t SlotMap::find_first_fit(std::size_t width, std::size_t from) const {
+    if (width == 0) {
+        return from <= capacity_ ? from : npos;
+    }
+    return fit_mask(width).find_next_set(from);
+}
+
+std::size_t SlotMap::find_next_set(std::size_t from) const {
+    for (std::size_t w = from / kWordBits; w < kWords; ++w) {
+        std::uint64_t v = words_[w];
+        if (w == from / kWordBits) {
+            v &= kAllOnes << (from % kWordBits);
+        }
+        if (v != 0) {
+            return w * kWordBits + static_cast<std::size_t>(__builtin_ctzll(v));
+        }
+    }
+    return npos;
+}
+
+std::size_t SlotMap::find_prev_set(std::size_t before) const {
+    before = std::min(before, kMaxSlots);
+
+    for (std::size_t w = (before + kWordBits - 1) / kWordBits; w-- > 0;) {
+        std::uint64_t v = words_[w];
+        const std::size_t bits = before - w * kWordBits;
+        if (bits < kWordBits) {
+            v &= (std::uint64_t{1} << bits) - 1;
+        }
+        if (v != 0) {
+            return w * kWordBits + 63 - static_cast<std::size_t>(__builtin_clzll(v));
+        }
+    }
+    return npos;
+}
+
+std::vector<std::size_t> SlotMap::to_offsets() const {
+    std::vector<std::size_t> offsets;
+    offsets.reserve(count());
+
+    for (std::size_t w = 0; w < kWords; ++w) {
+        std::uint64_t v = words_[w];
+        while (v != 0) {
+            offsets.push_back(
+                w * kWordBits + static_cast<std::size_t>(__builtin_ctzll(v))
+            );
+            v &= v - 1;
+        }
+    }
+    return offsets;
+}
+
+std::size_t SlotMap::write_offsets(std::uint8_t* out) const {
+    std::size_t n = 0;
+    for (std::size_t w = 0; w < kWords; ++w) {
+        std::uint64_t v = words_[w];
+        while (v != 0) {
+            out[n++] = static_cast<std::uint8_t>(
+                w * kWordBits + static_cast<std::size_t>(__builtin_ctzll(v))
+            );
+            v &= v - 1;
+        }
+    }
+    return n;
+}
+
+std::vector<bool> SlotMap::to_vector() const {
+    std::vector<bool> slots(capacity_, false);
+    for (std::size_t i = 0; i < capacity_; ++i) {
+        slots[i] = test(i);
+    }
+    return slots;
+}
+
+bool SlotMap::operator==(const SlotMap& other) const {
+    return capacity_ == other.capacity_ && words_ == other.words_;
+}
+
+} // namespace otn
@@ -0,0 +1,428 @@
+#include "otn/topology.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+
+namespace otn {
+
+// ---------------- TOPOLOGY ----------------
+
+NodeId Topology::add_node(const std::string& name) {
+    if (by_name_.count(name)) {
+        throw std::runtime_error("Duplicate node name: " + name);
+    }
+
+    const NodeId id = static_cast<NodeId>(names_.size());
+    names_.push_back(name);
+    by_name_.emplace(name, id);
+    adjacency_.emplace_back();
+    return id;
+}
+
+LinkId Topology::add_link(NodeId a, NodeId b, OduLevel level, double weight) {
+    if (a >= node_count() || b >= node_count()) {
+        throw std::runtime_error("Link endpoint is not a known node");
+    }
+    if (a == b) {
+        throw std::runtime_error("Self-loop links are not supported");
+    }
+    if (!(weight > 0.0)) {
+        throw std::runtime_error("Link weight must be positive");
+    }
+
+    const LinkId id = static_cast<LinkId>(links_.size());
+    links_.push_back({a, b, level, weight, SlotMap(tributary_slots(level)), 0});
+    adjacency_[a].push_back(id);
+    adjacency_[b].push_back(id);
+    return id;
+}
+
+NodeId Topology::node_id(const std::string& name) const {
+    auto it = by_name_.find(name);
+    if (it == by_name_.end()) {
+        throw std::runtime_error("Unknown node: " + name);
+    }
+    return it->second;
+}
+
+namespace {
+
+OduLevel parse_level(std::string token) {
+    if (token.size() > 3) {
+        const std::string prefix = token.substr(0, 3);
+        if (prefix == "ODU" || prefix == "OTU" || prefix == "odu" || prefix == "otu") {
+            token = token.substr(3);
+        }
+    }
+
+    if (token == "1") return OduLevel::ODU1;
+    if (token == "2") return OduLevel::ODU2;
+    if (token == "3") return OduLevel::ODU3;
+    if (token == "4") return OduLevel::ODU4;
+
+    throw std::runtime_error("Unknown link level: " + token);
+}
+
+} // anonymous namespace
+
+Topology Topology::from_edge_list(std::istream& in) {
+    Topology topo;
+
+    auto node = [&topo](const std::string& name) {
+        auto it = topo.by_name_.find(name);
+        return it != topo.by_name_.end() ? it->second : topo.add_node(name);
+    };
+
+    std::string line;
+    std::size_t line_no = 0;
+
+    while (std::getline(in, line)) {
+        ++line_no;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        std::istringstream fields(line);
+        std::string src, dst, level;
+        if (!(fields >> src) || src[0] == '#') continue;
+
+        if (!(fields >> dst >> level)) {
+            throw std::runtime_error(
+                "Malformed edge list line " + std::to_string(line_no)
+            );
+        }
+
+        double weight = 1.0;
+        std::string extra;
+        if (fields >> extra) {
+            try {
+                weight = std::stod(extra);
+            } catch (const std::exception&) {
+                throw std::runtime_error(
+                    "Bad link weight on line " + std::to_string(line_no)
+                );
+            }
+        }
+
+        topo.add_link(node(src), node(dst), parse_level(level), weight);
+    }
+
+    return topo;
+}
+
+Topology Topology::from_edge_list_file(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open edge list: " + path);
+    }
+    return from_edge_list(in);
+}
+
+bool Topology::reserve(LinkId id, std::size_t offset, std::size_t width) {
+    Link& l = links_[id];
+    if (offset + width > l.occupancy.capacity() || !l.occupancy.range_free(offset, width)) {
+        return false;
+    }
+    l.occupancy.set_range(offset, width);
+    ++l.version;
+    return true;
+}
+
+void Topology::release(LinkId id, std::size_t offset, std::size_t width) {
+    Link& l = links_[id];
+    if (l.occupancy.count_range(offset, width) != width) {
+        throw std::runtime_error("Releasing slots that are not reserved");
+    }
+    l.occupancy.clear_range(offset, width);
+    ++l.version;
+}
+
+// ---------------- ROUTER ----------------
+
+namespace {
+
+constexpr std::size_t kNotCached = SlotMap::npos - 1;
+
+} // anonymous namespace
+
+Router::Router(Topology& topology, std::size_t k)
+    : topology_(topology), k_(k)
+{
+    if (k_ == 0) {
+        throw std::runtime_error("Router needs k >= 1");
+    }
+}
+
+const std::vector<double>& Router::distances_to(NodeId dst) {
+    auto it = distance_cache_.find(dst);
+    if (it != distance_cache_.end()) return it->second;
+
+    std::vector<double> dist(
+        topology_.node_count(), std::numeric_limits<double>::infinity()
+    );
+
+    using Entry = std::pair<double, NodeId>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> frontier;
+
+    // Links are bidirectional, so distance to dst equals distance from it
+    dist[dst] = 0.0;
+    frontier.push({0.0, dst});
+
+    while (!frontier.empty()) {
+        const auto [d, u] = frontier.top();
+        frontier.pop();
+        if (d > dist[u]) continue;
+
+        for (LinkId id : topology_.links_at(u)) {
+            const Link& l = topology_.link(id);
+            const NodeId v = l.other(u);
+            if (d + l.weight < dist[v]) {
+                dist[v] = d + l.weight;
+                frontier.push({dist[v], v});
+            }
+        }
+    }
+
+    return distance_cache_.emplace(dst, std::move(dist)).first->second;
+}
+
+std::optional<Path> Router::shortest_path(NodeId src, NodeId dst) {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    const std::size_t n = topology_.node_count();
+    const std::vector<double>& h = distances_to(dst);
+
+    if (h[src] == inf) return std::nullopt;
+
+    dist_.assign(n, inf);
+    via_.assign(n, std::numeric_limits<LinkId>::max());
+
+    // Keyed on dist + h; h is consistent, so a popped node is final
+    using Entry = std::pair<double, NodeId>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> frontier;
+
+    dist_[src] = 0.0;
+    frontier.push({h[src], src});
+
+    while (!frontier.empty()) {
+        const auto [f, u] = frontier.top();
+        frontier.pop();
+        const double d = dist_[u];
+        if (f > d + h[u]) continue;
+        if (u == dst) break;
+
+        for (LinkId id : topology_.links_at(u)) {
+            if (blocked_links_[id]) continue;
+            const Link& l = topology_.link(id);
+            const NodeId v = l.other(u);
+            if (blocked_nodes_[v]) continue;
+
+            const double nd = d + l.weight;
+            // Tie-break on link id so equal-cost paths are deterministic
+            if (nd < dist_[v] || (nd == dist_[v] && id < via_[v])) {
+                dist_[v] = nd;
+                via_[v] = id;
+                frontier.push({nd + h[v], v});
+            }
+        }
+    }
+
+    if (dist_[dst] == inf) return std::nullopt;
+
+    Path path;
+    path.cost = dist_[dst];
+    for (NodeId v = dst; v != src; ) {
+        const LinkId id = via_[v];
+        path.nodes.push_back(v);
+        path.links.push_back(id);
+        v = topology_.link(id).other(v);
+    }
+    path.nodes.push_back(src);
+    std::reverse(path.nodes.begin(), path.nodes.end());
+    std::reverse(path.links.begin(), path.links.end());
+    return path;
+}
+
+void Router::sync_graph() {
+    // Nodes and links are only ever added, so the counts identify the graph
+    if (topology_.node_count() == graph_nodes_ && topology_.link_count() == graph_links_) return;
+
+    path_cache_.clear();
+    distance_cache_.clear();
+    graph_nodes_ = topology_.node_count();
+    graph_links_ = topology_.link_count();
+}
+
+Router::PairPaths& Router::pair(NodeId src, NodeId dst) {
+    sync_graph();
+
+    if (src >= topology_.node_count() || dst >= topology_.node_count()) {
+        throw std::runtime_error("Route endpoint is not a known node");
+    }
+
+    const uint64_t key = (static_cast<uint64_t>(src) << 32) | dst;
+    return path_cache_[key];
+}
+
+bool Router::extend(PairPaths& pp, NodeId src, NodeId dst) {
+    if (pp.exhausted || pp.accepted.size() >= k_) return false;
+
+    blocked_nodes_.assign(topology_.node_count(), false);
+    blocked_links_.assign(topology_.link_count(), false);
+
+    if (pp.accepted.empty()) {
+        auto first = shortest_path(src, dst);
+        if (!first) {
+            pp.exhausted = true;
+            return false;
+        }
+        pp.accepted.push_back(std::move(*first));
+        return true;
+    }
+
+    // Yen: deviate from every spur node of the last accepted path
+    const Path& last = pp.accepted.back();
+
+    for (std::size_t i = 0; i + 1 < last.nodes.size(); ++i) {
+        const NodeId spur = last.nodes[i];
+
+        // Block the next link of every accepted path sharing this root
+        for (const Path& p : pp.accepted) {
+            if (p.nodes.size() > i + 1 &&
+                std::equal(last.nodes.begin(), last.nodes.begin() + i + 1, p.nodes.begin())) {
+                blocked_links_[p.links[i]] = true;
+            }
+        }
+        // Root nodes other than the spur must not be revisited
+        for (std::size_t j = 0; j < i; ++j) blocked_nodes_[last.nodes[j]] = true;
+
+        auto spur_path = shortest_path(spur, dst);
+
+        std::fill(blocked_nodes_.begin(), blocked_nodes_.end(), false);
+        std::fill(blocked_links_.begin(), blocked_links_.end(), false);
+
+        if (!spur_path) continue;
+
+        Path total;
+        total.nodes.assign(last.nodes.begin(), last.nodes.begin() + i);
+        total.nodes.insert(total.nodes.end(), spur_path->nodes.begin(), spur_path->nodes.end());
+        total.links.assign(last.links.begin(), last.links.begin() + i);
+        total.links.insert(total.links.end(), spur_path->links.begin(), spur_path->links.end());
+        total.cost = spur_path->cost;
+        for (std::size_t j = 0; j < i; ++j) {
+            total.cost += topology_.link(last.links[j]).weight;
+        }
+
+        auto same = [&total](const Path& p) { return p.links == total.links; };
+        if (std::none_of(pp.candidates.begin(), pp.candidates.end(), same) &&
+            std::none_of(pp.accepted.begin(), pp.accepted.end(), same)) {
+            pp.candidates.push_back(std::move(total));
+        }
+    }
+
+    if (pp.candidates.empty()) {
+        pp.exhausted = true;
+        return false;
+    }
+
+    auto best = std::min_element(
+        pp.candidates.begin(), pp.candidates.end(),
+        [](const Path& a, const Path& b) {
+            if (a.cost != b.cost) return a.cost < b.cost;
+            return a.links < b.links;
+        }
+    );
+    pp.accepted.push_back(std::move(*best));
+    pp.candidates.erase(best);
+    return true;
+}
+
+const std::vector<Path>& Router::paths(NodeId src, NodeId dst) {
+    PairPaths& pp = pair(src, dst);
+    while (extend(pp, src, dst)) {}
+    return pp.accepted;
+}
+
+std::size_t Router::first_fit(LinkId id, OduLevel demand) {
+    if (link_cache_.size() < topology_.link_count()) {
+        link_cache_.resize(topology_.link_count());
+    }
+
+    const Link& l = topology_.link(id);
+    LinkCache& cache = link_cache_[id];
+
+    if (cache.version != l.version) {
+        cache.version = l.version;
+        cache.first_fit.fill(kNotCached);
+    }
+
+    std::size_t& offset = cache.first_fit[static_cast<uint8_t>(demand)];
+    if (offset == kNotCached) {
+        const std::size_t width = tributary_slots(demand);
+        offset = width <= l.occupancy.capacity()
+            ? l.occupancy.find_first_fit(width)
+            : SlotMap::npos;
+    }
+    return offset;
+}
+
+std::optional<Route> Router::find_route(NodeId src, NodeId dst, OduLevel demand) {
+    if (src == dst) {
+        throw std::runtime_error("Route endpoints must differ");
+    }
+
+    PairPaths& pp = pair(src, dst);
+
+    for (std::size_t i = 0; i < pp.accepted.size() || extend(pp, src, dst); ++i) {
+        const Path& path = pp.accepted[i];
+
+        Route route;
+        route.slot_width = tributary_slots(demand);
+        route.cost = path.cost;
+        route.offsets.reserve(path.links.size());
+
+        bool feasible = true;
+        for (LinkId id : path.links) {
+            const std::size_t offset = first_fit(id, demand);
+            if (offset == SlotMap::npos) {
+                feasible = false;
+                break;
+            }
+            route.offsets.push_back(static_cast<uint16_t>(offset));
+        }
+
+        if (feasible) {
+            route.links = path.links;
+            return route;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<Route> Router::route_and_reserve(NodeId src, NodeId dst, OduLevel demand) {
+    auto route = find_route(src, dst, demand);
+    if (route) reserve(*route);
+    return route;
+}
+
+void Router::reserve(const Route& route) {
+    for (std::size_t i = 0; i < route.links.size(); ++i) {
+        if (!topology_.reserve(route.links[i], route.offsets[i], route.slot_width)) {
+            // Roll back the hops already taken
+            for (std::size_t j = 0; j < i; ++j) {
+                topology_.release(route.links[j], route.offsets[j], route.slot_width);
+            }
+            throw std::runtime_error("Route slots are no longer free");
+        }
+    }
+}
+
+void Router::release(const Route& route) {
+    for (std::size_t i = 0; i < route.links.size(); ++i) {
+        topology_.release(route.links[i], route.offsets[i], route.slot_width);
+    }
+}
+
+} // namespace otn
@@ -0,0 +1,516 @@
+#include "otn/trace.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace otn {
+
+namespace {
+
+constexpr uint32_t kTraceEndianTag = 0x01020304;
+
+// Parsed pages of the mapping are dropped in steps of this size
+constexpr std::size_t kReleaseBytes = std::size_t{64} << 20;
+
+struct Field {
+    const char* first;
+    const char* last;
+
+    bool empty() const { return first == last; }
+};
+
+Field trim(const char* first, const char* last) {
+    while (first < last && (*first == ' ' || *first == '\t')) ++first;
+    while (last > first && (last[-1] == ' ' || last[-1] == '\t')) --last;
+    return {first, last};
+}
+
+template <typename T>
+bool parse_number(Field f, T& out) {
+    if (f.empty()) return false;
+    const char* first = f.first;
+    if (*first == '+') ++first;
+    const auto r = std::from_chars(first, f.last, out);
+    return r.ec == std::errc() && r.ptr == f.last;
+}
+
+bool equals_nocase(Field f, const char* word) {
+    const std::size_t n = std::strlen(word);
+    if (static_cast<std::size_t>(f.last - f.first) != n) return false;
+    for (std::size_t i = 0; i < n; ++i) {
+        char c = f.first[i];
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c != word[i]) return false;
+    }
+    return true;
+}
+
+bool parse_level(Field f, OduLevel& out) {
+    if (f.last - f.first == 4 && (f.first[0] == 'O' || f.first[0] == 'o')) {
+        if (!equals_nocase({f.first, f.first + 3}, "odu")) return false;
+        f.first += 3;
+    }
+    if (f.last - f.first != 1 || *f.first < '1' || *f.first > '4') return false;
+    out = static_cast<OduLevel>(*f.first - '0');
+    return true;
+}
+
+// Parses one CSV line into r; returns an error message or nullptr
+const char* parse_csv_line(const char* first, const char* last, TraceRecord& r) {
+    Field fields[6];
+    std::size_t count = 0;
+
+    for (const char* p = first;; ) {
+        const char* comma = static_cast<const char*>(std::memchr(p, ',', static_cast<std::size_t>(last - p)));
+        const char* field_end = comma ? comma : last;
+        if (count == 6) return "too many fields";
+        fields[count++] = trim(p, field_end);
+        if (!comma) break;
+        p = comma + 1;
+    }
+
+    if (count < 3) return "expected timestamp,op,demand_id[,level,payload_bytes[,preferred_parent]]";
+
+    if (!parse_number(fields[0], r.timestamp)) return "bad timestamp";
+
+    if (equals_nocase(fields[1], "add")) {
+        r.op = TraceOp::ADD;
+    } else if (equals_nocase(fields[1], "remove")) {
+        r.op = TraceOp::REMOVE;
+    } else {
+        return "unknown operation (expected add or remove)";
+    }
+
+    if (!parse_number(fields[2], r.demand_id)) return "bad demand id";
+
+    const bool has_level   = count > 3 && !fields[3].empty();
+    const bool has_payload = count > 4 && !fields[4].empty();
+
+    if (r.op == TraceOp::ADD && (!has_level || !has_payload)) {
+        return "add needs level and payload_bytes";
+    }
+    if (has_level && !parse_level(fields[3], r.level)) return "bad ODU level";
+    if (has_payload && !parse_number(fields[4], r.payload_bytes)) return "bad payload size";
+
+    if (count > 5 && !fields[5].empty() && !parse_number(fields[5], r.preferred_parent)) {
+        return "bad preferred parent";
+    }
+    return nullptr;
+}
+
+// Checks shared by both formats; returns an error message or nullptr
+const char* check_record(const TraceRecord& r, double& last_time) {
+    if (!std::isfinite(r.timestamp)) return "bad timestamp";
+    if (r.timestamp < last_time) return "timestamp goes backwards";
+    last_time = r.timestamp;
+
+    if (r.op == TraceOp::REMOVE) return nullptr;
+    if (r.op != TraceOp::ADD) return "unknown operation";
+
+    const uint8_t level = static_cast<uint8_t>(r.level);
+    if (level < 1 || level > 4) return "bad ODU level";
+    if (r.payload_bytes > nominal_capacity(r.level)) {
+        return "ODU payload exceeds nominal capacity";
+    }
+    return nullptr;
+}
+
+// A first CSV line that cannot start a record is a column header
+bool is_header_line(const char* first, const char* last) {
+    const Field f = trim(first, last);
+    if (f.empty()) return false;
+    const char c = *f.first;
+    return !(c == '+' || c == '-' || c == '.' || (c >= '0' && c <= '9'));
+}
+
+} // anonymous namespace
+
+// ---------------- WRITER ----------------
+
+BinaryTraceWriter::BinaryTraceWriter(const std::string& path)
+    : out_(path, std::ios::binary | std::ios::trunc)
+{
+    if (!out_) {
+        throw std::runtime_error("Cannot open trace file: " + path);
+    }
+
+    TraceFileHeader header{};
+    std::memcpy(header.magic, kTraceMagic, sizeof(header.magic));
+    header.version = kTraceVersion;
+    header.endian_tag = kTraceEndianTag;
+    header.record_bytes = sizeof(TraceRecord);
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void BinaryTraceWriter::write(const TraceRecord& record) {
+    out_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    if (!out_) {
+        throw std::runtime_error("Failed to write trace");
+    }
+    ++written_;
+}
+
+void BinaryTraceWriter::close() {
+    out_.close();
+    if (!out_) {
+        throw std::runtime_error("Failed to write trace");
+    }
+}
+
+// ---------------- READER ----------------
+
+TraceReader::TraceReader(const std::string& path, TraceReaderOptions options)
+    : options_(options),
+      file_(path),
+      format_(options.format),
+      ready_(options.queue_chunks),
+      recycled_(options.queue_chunks + 2)
+{
+    if (options_.chunk_records == 0) {
+        throw std::runtime_error("Trace chunk size must be positive");
+    }
+
+    const bool has_magic = file_.size() >= sizeof(kTraceMagic) &&
+        std::memcmp(file_.data(), kTraceMagic, sizeof(kTraceMagic)) == 0;
+    if (format_ == TraceFormat::AUTO) {
+        format_ = has_magic ? TraceFormat::BINARY : TraceFormat::CSV;
+    }
+
+    // Binary framing problems are reported before any record is read
+    if (format_ == TraceFormat::BINARY) {
+        TraceFileHeader header{};
+        if (file_.size() < sizeof(header) || !has_magic) {
+            throw std::runtime_error("Not a binary trace: " + path);
+        }
+        std::memcpy(&header, file_.data(), sizeof(header));
+        if (header.endian_tag != kTraceEndianTag) {
+            throw std::runtime_error("Binary trace has foreign byte order");
+        }
+        if (header.version != kTraceVersion || header.record_bytes != sizeof(TraceRecord)) {
+            throw std::runtime_error("Unsupported binary trace version");
+        }
+        if ((file_.size() - sizeof(header)) % sizeof(TraceRecord) != 0) {
+            throw std::runtime_error("Truncated binary trace");
+        }
+    }
+
+    file_.advise_sequential();
+    parser_ = std::thread([this] { produce(); });
+}
+
+TraceReader::~TraceReader() {
+    ready_.close();
+    recycled_.close();
+    if (parser_.joinable()) {
+        parser_.join();
+    }
+}
+
+std::vector<TraceRecord> TraceReader::fresh_buffer() {
+    std::vector<TraceRecord> buffer;
+    recycled_.try_pop(buffer);
+    buffer.clear();
+    buffer.reserve(options_.chunk_records);
+    return buffer;
+}
+
+bool TraceReader::emit(std::vector<TraceRecord>& buffer) {
+    Chunk chunk{std::move(buffer), nullptr};
+    buffer = fresh_buffer();
+    return ready_.push(std::move(chunk));
+}
+
+void TraceReader::produce() {
+    std::vector<TraceRecord> buffer = fresh_buffer();
+    try {
+        if (format_ == TraceFormat::BINARY) {
+            parse_binary(buffer);
+        } else {
+            parse_csv(buffer);
+        }
+        if (!buffer.empty()) {
+            emit(buffer);
+        }
+    } catch (...) {
+        // Records parsed before the error still reach the consumer first
+        if (buffer.empty() || emit(buffer)) {
+            ready_.push({{}, std::current_exception()});
+        }
+    }
+    ready_.close();
+}
+
+void TraceReader::parse_csv(std::vector<TraceRecord>& buffer) {
+    const char* const begin = file_.data();
+    const char* const end = begin + file_.size();
+    const char* p = begin;
+
+    uint64_t line = 0;
+    double last_time = -std::numeric_limits<double>::infinity();
+    std::size_t released = 0;
+
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        if (!eol) eol = end;
+
+        const char* first = p;
+        const char* last = eol;
+        if (last > first && last[-1] == '\r') --last;
+        p = eol < end ? eol + 1 : end;
+        ++line;
+
+        const Field content = trim(first, last);
+        if (content.empty() || *content.first == '#') continue;
+        if (line == 1 && is_header_line(first, last)) continue;
+
+        TraceRecord r;
+        const char* error = parse_csv_line(first, last, r);
+        if (!error) error = check_record(r, last_time);
+        if (error) {
+            throw std::runtime_error("Trace line " + std::to_string(line) + ": " + error);
+        }
+
+        buffer.push_back(r);
+        if (buffer.size() == options_.chunk_records) {
+            if (!emit(buffer)) return;
+
+            const std::size_t parsed = static_cast<std::size_t>(p - begin);
+            if (parsed - released >= kReleaseBytes) {
+                file_.release_prefix(parsed);
+                released = parsed;
+            }
+        }
+    }
+}
+
+void TraceReader::parse_binary(std::vector<TraceRecord>& buffer) {
+    const char* const records = file_.data() + sizeof(TraceFileHeader);
+    const std::size_t total = (file_.size() - sizeof(TraceFileHeader)) / sizeof(TraceRecord);
+
+    double last_time = -std::numeric_limits<double>::infinity();
+    std::size_t released = 0;
+
+    for (std::size_t i = 0; i < total; ) {
+        const std::size_t n = std::min(options_.chunk_records, total - i);
+        buffer.resize(n);
+        std::memcpy(buffer.data(), records + i * sizeof(TraceRecord), n * sizeof(TraceRecord));
+
+        for (std::size_t k = 0; k < n; ++k) {
+            if (const char* error = check_record(buffer[k], last_time)) {
+                buffer.resize(k);
+                throw std::runtime_error("Trace record " + std::to_string(i + k + 1) + ": " + error);
+            }
+        }
+        i += n;
+
+        if (!emit(buffer)) return;
+
+        const std::size_t parsed = sizeof(TraceFileHeader) + i * sizeof(TraceRecord);
+        if (parsed - released >= kReleaseBytes) {
+            file_.release_prefix(parsed);
+            released = parsed;
+        }
+    }
+}
+
+bool TraceReader::pop_chunk(std::vector<TraceRecord>& chunk) {
+    if (finished_) return false;
+
+    // Hand the spent buffer back to the parser
+    if (chunk.capacity() > 0) {
+        chunk.clear();
+        recycled_.try_push(std::move(chunk));
+        chunk = {};
+    }
+
+    Chunk c;
+    if (!ready_.pop(c)) {
+        finished_ = true;
+        return false;
+    }
+    if (c.error) {
+        finished_ = true;
+        std::rethrow_exception(c.error);
+    }
+    chunk = std::move(c.records);
+    return true;
+}
+
+bool TraceReader::next_chunk(std::vector<TraceRecord>& chunk) {
+    if (!pop_chunk(chunk)) return false;
+    delivered_ += chunk.size();
+    return true;
+}
+
+bool TraceReader::next(TraceRecord& out) {
+    while (current_pos_ == current_.size()) {
+        current_pos_ = 0;
+        if (!pop_chunk(current_)) return false;
+    }
+    out = current_[current_pos_++];
+    ++delivered_;
+    return true;
+}
+
+// ---------------- REPLAY ----------------
+
+TraceReplayer::TraceReplayer(ReplayConfig config)
+    : config_(std::move(config))
+{
+    if (config_.parent_count == 0) {
+        throw std::runtime_error("Replay needs at least one parent ODU");
+    }
+
+    parents_.assign(
+        config_.parent_count,
+        AdmissionEngine(config_.parent_level, {}, cost_policy_picks(config_.policy))
+    );
+    parent_cost_.assign(config_.parent_count, 0.0);
+}
+
+void TraceReplayer::advance_clock(double now) {
+    if (!started_) {
+        started_ = true;
+        first_time_ = now;
+    } else {
+        const double capacity =
+            static_cast<double>(tributary_slots(config_.parent_level)) *
+            static_cast<double>(parents_.size());
+        utilization_area_ += (now - clock_) * static_cast<double>(occupied_slots_) / capacity;
+    }
+    clock_ = now;
+}
+
+void TraceReplayer::update_cost(uint32_t p) {
+    const double cost = fragmentation_cost(parents_[p].fragmentation().metrics());
+    total_cost_ += cost - parent_cost_[p];
+    parent_cost_[p] = cost;
+}
+
+bool TraceReplayer::try_parent(uint32_t p, const Odu& child, Placement& placement) {
+    AdmissionEngine& engine = parents_[p];
+
+    const AdmissionResult r = dispatch_cost_policy(
+        config_.policy, config_.cost_weights,
+        [&](const auto& policy) { return engine.best_placement(child, policy); }
+    );
+    if (!r.admitted) return false;
+    const std::size_t offset = r.chosen_offset;
+
+    engine.commit(&child, offset);
+
+    placement.parent = p;
+    placement.offset = static_cast<uint16_t>(offset);
+    placement.width  = static_cast<uint16_t>(child.slots());
+
+    occupied_slots_ += placement.width;
+    update_cost(p);
+    return true;
+}
+
+bool TraceReplayer::admit(const TraceRecord& record, Placement& placement) {
+    const Odu& child = prototypes_[record.level];
+    const uint32_t preferred = record.preferred_parent;
+
+    if (preferred < parents_.size() && try_parent(preferred, child, placement)) {
+        ++stats_.preferred_parent_hits;
+        return true;
+    }
+
+    for (uint32_t p = 0; p < parents_.size(); ++p) {
+        if (p != preferred && try_parent(p, child, placement)) return true;
+    }
+    return false;
+}
+
+void TraceReplayer::apply(const TraceRecord& record) {
+    advance_clock(record.timestamp);
+    ++stats_.records;
+
+    if (record.op == TraceOp::REMOVE) {
+        ++stats_.removes;
+
+        const auto it = active_.find(record.demand_id);
+        if (it == active_.end()) {
+            ++stats_.unknown_removes;
+            return;
+        }
+
+        const Placement placement = it->second;
+        active_.erase(it);
+
+        parents_[placement.parent].release(placement.offset, placement.width);
+        occupied_slots_ -= placement.width;
+        update_cost(placement.parent);
+        return;
+    }
+
+    const uint8_t level = static_cast<uint8_t>(record.level);
+    if (level < 1 || level > 4) {
+        throw std::runtime_error("Unknown ODU level");
+    }
+    if (record.level >= config_.parent_level) {
+        throw std::runtime_error(
+            "ODU" + std::to_string(level) + " demands cannot be groomed into ODU" +
+            std::to_string(static_cast<int>(config_.parent_level)) + " parents"
+        );
+    }
+
+    if (active_.count(record.demand_id) != 0) {
+        ++stats_.duplicate_adds;
+        return;
+    }
+
+    ++stats_.adds;
+    ++stats_.adds_per_level[level];
+
+    Placement placement;
+    if (!admit(record, placement)) {
+        ++stats_.blocked;
+        ++stats_.blocked_per_level[level];
+        return;
+    }
+
+    ++stats_.admitted;
+    active_.emplace(record.demand_id, placement);
+}
+
+ReplayStats TraceReplayer::stats() const {
+    ReplayStats s = stats_;
+
+    const double capacity =
+        static_cast<double>(tributary_slots(config_.parent_level)) *
+        static_cast<double>(parents_.size());
+
+    s.final_utilization = static_cast<double>(occupied_slots_) / capacity;
+    s.final_fragmentation_cost = total_cost_ / static_cast<double>(parents_.size());
+    s.trace_duration = started_ ? clock_ - first_time_ : 0.0;
+
+    if (s.adds > 0) {
+        s.blocking_probability = static_cast<double>(s.blocked) / static_cast<double>(s.adds);
+    }
+    s.mean_utilization = s.trace_duration > 0.0
+        ? utilization_area_ / s.trace_duration
+        : s.final_utilization;
+
+    return s;
+}
+
+ReplayStats replay_trace(TraceReader& reader, const ReplayConfig& config) {
+    TraceReplayer replayer(config);
+
+    std::vector<TraceRecord> chunk;
+    while (reader.next_chunk(chunk)) {
+        for (const TraceRecord& r : chunk) {
+            replayer.apply(r);
+        }
+    }
+    return replayer.stats();
+}
+
+} // namespace otn
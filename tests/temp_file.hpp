@@ -0,0 +1,56 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace otn::test {
+
+/*
+ *  - File in the temp directory, removed when the test ends
+ *  - The name is prefixed with the process id and the running test, so
+ *    parallel ctest runs and CI jobs sharing a temp directory never collide
+ */
+class TempFile {
+public:
+    explicit TempFile(const std::string& name) : path_(unique_path(name)) {}
+    ~TempFile() { std::remove(path_.c_str()); }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const std::string& path() const { return path_; }
+
+    // Name without the directory, for files that refer to each other
+    std::string filename() const { return std::filesystem::path(path_).filename().string(); }
+
+    void write(const std::string& text) const {
+        std::ofstream(path_, std::ios::binary) << text;
+    }
+
+private:
+    static std::string unique_path(const std::string& name) {
+#ifdef _WIN32
+        std::string prefix = "otn_" + std::to_string(::_getpid());
+#else
+        std::string prefix = "otn_" + std::to_string(::getpid());
+#endif
+        if (const auto* info = ::testing::UnitTest::GetInstance()->current_test_info()) {
+            prefix += std::string("_") + info->test_suite_name() + "_" + info->name();
+        }
+        return (std::filesystem::temp_directory_path() / (prefix + "_" + name)).string();
+    }
+
+    std::string path_;
+};
+
+} // namespace otn::test
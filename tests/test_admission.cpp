@@ -1,9 +1,12 @@
 #include <gtest/gtest.h>
 
 #include "otn/grooming_planner.hpp"
+#include "otn/candidate.hpp"
 #include "otn/odu.hpp"
 #include "otn/otn_types.hpp"
 
+#include <string>
+
 using namespace otn;
 
 /*
@@ -211,7 +214,142 @@ TEST(AdmitCandidates, CostTieBreakIsStable) {
         { c1, c2 }
     );
 
-    ASSERT_EQ(result.size(), 2u);
+    // First-seen child wins the contested slot; b is not double-booked
+    ASSERT_EQ(result.size(), 1u);
     EXPECT_EQ(result[0].child, &a);
+    EXPECT_EQ(result[0].slot_offset, 0u);
+}
+
+TEST(AdmitCandidates, PendingAdmissionsBlockLaterChildren) {
+    Odu a(OduLevel::ODU1, 100);
+    Odu b(OduLevel::ODU1, 100);
+
+    // b prefers slot 0 but a already took it in this batch
+    std::vector<Candidate> candidates = {
+        { &a, 0, 0.0 },
+        { &b, 0, 0.0 },
+        { &b, 1, 0.0 }
+    };
+
+    auto result = admit_candidates(
+        OduLevel::ODU2,
+        {},
+        candidates
+    );
+
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].slot_offset, 0u);
     EXPECT_EQ(result[1].child, &b);
+    EXPECT_EQ(result[1].slot_offset, 1u);
+}
+
+// ---------------- Feasibility table ----------------
+
+TEST(FeasibilityTable, MasksMatchPerLevelFitMasks) {
+    Odu a(OduLevel::ODU3, 100);
+    Odu b(OduLevel::ODU3, 100);
+    std::vector<GroomedChild> grooming = {
+        GroomedChild(&a, 16, 5),
+        GroomedChild(&b, 16, 40)
+    };
+
+    FeasibilityTable table(OduLevel::ODU4, grooming);
+    const SlotMap occupied = occupied_slot_map(OduLevel::ODU4, grooming);
+
+    for (OduLevel level : {OduLevel::ODU1, OduLevel::ODU2, OduLevel::ODU3, OduLevel::ODU4}) {
+        EXPECT_EQ(table.mask(level), occupied.fit_mask(tributary_slots(level)));
+    }
+
+    Odu candidate(OduLevel::ODU3, 100);
+    EXPECT_EQ(
+        feasible_offsets(table, candidate),
+        feasible_offsets(OduLevel::ODU4, grooming, candidate)
+    );
+    EXPECT_TRUE(table.mask(OduLevel::ODU4).none());
+}
+
+TEST(FeasibilityTable, EngineRefreshesAfterCommitAndRelease) {
+    Odu child(OduLevel::ODU1, 100);
+    AdmissionEngine engine(OduLevel::ODU2, {});
+
+    EXPECT_EQ(engine.feasible_mask(OduLevel::ODU1).count(), 4u);
+    EXPECT_TRUE(engine.feasibility().fits(OduLevel::ODU2, 0));
+
+    engine.commit(&child, 1);
+    EXPECT_EQ(engine.feasible_mask(OduLevel::ODU1).count(), 3u);
+    EXPECT_FALSE(engine.feasibility().fits(OduLevel::ODU2, 0));
+
+    engine.release(1, 1);
+    EXPECT_TRUE(engine.feasibility().fits(OduLevel::ODU2, 0));
+}
+
+// ---------------- Batch admission ----------------
+
+TEST(AdmitCandidatesBatch, MatchesSequentialAdmission) {
+    std::vector<Odu> leaves;
+    leaves.reserve(64);
+    for (int i = 0; i < 64; ++i) {
+        leaves.emplace_back(OduLevel::ODU3, 100);
+    }
+
+    std::vector<AdmissionJob> jobs;
+    for (std::size_t j = 0; j < 40; ++j) {
+        AdmissionJob job{OduLevel::ODU4, {}, {}};
+
+        // A pre-existing child at a job-specific offset fragments the parent
+        job.current.emplace_back(&leaves[j % leaves.size()], (j * 7) % 64);
+
+        for (std::size_t k = 0; k < 6; ++k) {
+            const Odu* child = &leaves[(j + k + 1) % leaves.size()];
+            job.candidates.push_back({ child, (j + 5 * k) % 64, 0.0 });
+            job.candidates.push_back({ child, (j * 3 + 16 * k) % 64, 0.0 });
+        }
+        jobs.push_back(std::move(job));
+    }
+
+    auto batch = admit_candidates_batch(jobs, 4);
+
+    ASSERT_EQ(batch.size(), jobs.size());
+    for (std::size_t j = 0; j < jobs.size(); ++j) {
+        auto expected = admit_candidates(
+            jobs[j].parent_level, jobs[j].current, jobs[j].candidates
+        );
+
+        ASSERT_EQ(batch[j].size(), expected.size()) << "job " << j;
+        for (std::size_t k = 0; k < expected.size(); ++k) {
+            EXPECT_EQ(batch[j][k].child, expected[k].child);
+            EXPECT_EQ(batch[j][k].slot_offset, expected[k].slot_offset);
+        }
+    }
+}
+
+TEST(AdmitCandidatesBatch, PropagatesLowestFailingJob) {
+    Odu leaf(OduLevel::ODU1, 100);
+
+    std::vector<AdmissionJob> jobs(8, AdmissionJob{OduLevel::ODU2, {}, {}});
+    for (auto& job : jobs) {
+        job.candidates.push_back({ &leaf, 0, 0.0 });
+    }
+    // Two failures with different messages; job 2 must win whatever the scheduling
+    jobs[5].candidates.push_back({ nullptr, 0, 0.0 });
+    jobs[2].current = {GroomedChild(&leaf, 1), GroomedChild(&leaf, 1)};
+
+    for (std::size_t threads : {1u, 3u, 8u}) {
+        try {
+            admit_candidates_batch(jobs, threads);
+            FAIL() << "expected an error with " << threads << " threads";
+        } catch (const std::runtime_error& e) {
+            EXPECT_NE(std::string(e.what()).find("Overlapping"), std::string::npos)
+                << threads << " threads: " << e.what();
+        }
+    }
+
+    // With job 2 fixed, job 5's error comes through instead
+    jobs[2].current.clear();
+    try {
+        admit_candidates_batch(jobs, 3);
+        FAIL() << "expected an error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_STREQ(e.what(), "Null candidate child");
+    }
 }
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include "otn/container_tree.hpp"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace otn;
+
+TEST(ContainerTreeTest, Odu1IntoEmptyOdu4OpensBothIntermediates) {
+    ContainerTree tree;
+    const ContainerId root = tree.add_root(OduLevel::ODU4);
+
+    const HierarchicalPlacement first = tree.place(OduLevel::ODU1);
+    ASSERT_TRUE(first.admitted);
+    EXPECT_EQ(first.anchor, root);
+    EXPECT_EQ(first.opened, 2u);
+    EXPECT_EQ(tree.level(first.container), OduLevel::ODU2);
+    EXPECT_EQ(tree.level(tree.parent(first.container)), OduLevel::ODU3);
+    EXPECT_EQ(tree.parent(tree.parent(first.container)), root);
+    EXPECT_EQ(tree.container_count(), 3u);
+
+    // The partially filled ODU2 is reused
+    const HierarchicalPlacement second = tree.place(OduLevel::ODU1);
+    ASSERT_TRUE(second.admitted);
+    EXPECT_EQ(second.opened, 0u);
+    EXPECT_EQ(second.container, first.container);
+    EXPECT_EQ(second.offset, 1u);
+
+    // Once the ODU2 is full, a sibling opens inside the same ODU3
+    tree.place(OduLevel::ODU1);
+    tree.place(OduLevel::ODU1);
+    const HierarchicalPlacement fifth = tree.place(OduLevel::ODU1);
+    EXPECT_EQ(fifth.opened, 1u);
+    EXPECT_EQ(tree.parent(fifth.container), tree.parent(first.container));
+    EXPECT_FALSE(tree.can_host(first.container, OduLevel::ODU1));
+    EXPECT_TRUE(tree.verify_summaries());
+}
+
+TEST(ContainerTreeTest, ReusesIntermediatesInLaterRootsBeforeOpening) {
+    ContainerTree tree;
+    tree.add_root(OduLevel::ODU4);
+    const ContainerId busy = tree.add_root(OduLevel::ODU4);
+
+    const ContainerId odu3 = tree.open_container(busy, 16);
+    const ContainerId odu2 = tree.open_container(odu3, 8);
+    tree.place_at(odu2, 0);
+
+    const HierarchicalPlacement p = tree.place(OduLevel::ODU1);
+    ASSERT_TRUE(p.admitted);
+    EXPECT_EQ(p.opened, 0u);
+    EXPECT_EQ(p.container, odu2);
+
+    // An ODU2 demand goes straight into the existing ODU3
+    const HierarchicalPlacement q = tree.place(OduLevel::ODU2);
+    EXPECT_EQ(q.opened, 0u);
+    EXPECT_EQ(q.container, odu3);
+}
+
+TEST(ContainerTreeTest, FullSubtreesAreNotVisited) {
+    ContainerTree tree;
+    const ContainerId root = tree.add_root(OduLevel::ODU4);
+
+    // Five ODU3s of full ODU2s
+    std::vector<ContainerId> odu3s;
+    std::vector<DemandId> demands;
+    for (std::size_t i = 0; i < 5; ++i) {
+        odu3s.push_back(tree.open_container(root, 16 * i));
+        for (std::size_t j = 0; j < 4; ++j) {
+            const ContainerId odu2 = tree.open_container(odu3s.back(), 4 * j);
+            for (std::size_t k = 0; k < 4; ++k) demands.push_back(tree.place_at(odu2, k));
+        }
+    }
+    EXPECT_FALSE(tree.can_host(root, OduLevel::ODU1));
+    EXPECT_FALSE(tree.place(OduLevel::ODU1).admitted);
+
+    // Free one ODU1 deep inside the fourth ODU3
+    const ContainerId odu2 = tree.children(odu3s[3])[2];
+    tree.release(demands[3 * 16 + 2 * 4 + 1]);
+    EXPECT_TRUE(tree.can_host(root, OduLevel::ODU1));
+    EXPECT_FALSE(tree.can_host(root, OduLevel::ODU2));
+
+    const HierarchicalPlacement p = tree.place(OduLevel::ODU1);
+    ASSERT_TRUE(p.admitted);
+    EXPECT_EQ(p.container, odu2);
+    EXPECT_EQ(p.visited, 3u);   // root, the fourth ODU3, the one ODU2
+    EXPECT_TRUE(tree.verify_summaries());
+}
+
+TEST(ContainerTreeTest, ReleaseClosesEmptyIntermediates) {
+    ContainerTree tree;
+    const ContainerId root = tree.add_root(OduLevel::ODU4);
+
+    const HierarchicalPlacement a = tree.place(OduLevel::ODU1);
+    const HierarchicalPlacement b = tree.place(OduLevel::ODU1);
+    EXPECT_EQ(tree.container_count(), 3u);
+
+    tree.release(a.demand);
+    EXPECT_EQ(tree.container_count(), 3u);
+    tree.release(b.demand);
+    EXPECT_EQ(tree.container_count(), 1u);
+    EXPECT_TRUE(tree.occupancy(root).none());
+    EXPECT_TRUE(tree.children(root).empty());
+    EXPECT_THROW(tree.release(b.demand), std::runtime_error);
+
+    ContainerTreeConfig keep;
+    keep.close_empty_containers = false;
+    ContainerTree kept(keep);
+    kept.add_root(OduLevel::ODU4);
+    kept.release(kept.place(OduLevel::ODU1).demand);
+    EXPECT_EQ(kept.container_count(), 3u);
+    EXPECT_EQ(kept.place(OduLevel::ODU1).opened, 0u);
+}
+
+TEST(ContainerTreeTest, RejectsInvalidExplicitPlacements) {
+    ContainerTree tree;
+    const ContainerId root = tree.add_root(OduLevel::ODU3);
+    const ContainerId odu2 = tree.open_container(root, 4);
+
+    EXPECT_THROW(tree.open_container(root, 6), std::runtime_error);    // overlaps
+    EXPECT_THROW(tree.open_container(root, 14), std::runtime_error);   // past the end
+    EXPECT_THROW(tree.place_at(odu2, 4), std::runtime_error);
+    EXPECT_THROW(tree.open_container(tree.add_root(OduLevel::ODU1), 0), std::runtime_error);
+    EXPECT_FALSE(tree.place(OduLevel::ODU4).admitted);
+}
+
+TEST(ContainerTreeTest, ChurnKeepsSummariesExact) {
+    ContainerTree tree;
+    for (int i = 0; i < 3; ++i) tree.add_root(OduLevel::ODU4);
+
+    std::mt19937_64 rng(11);
+    std::vector<DemandId> active;
+
+    for (int step = 0; step < 4000; ++step) {
+        if (!active.empty() && rng() % 5 < 2) {
+            const std::size_t i = rng() % active.size();
+            tree.release(active[i]);
+            active[i] = active.back();
+            active.pop_back();
+        } else {
+            const auto level = static_cast<OduLevel>(1 + rng() % 3);
+
+            bool hostable = false;
+            for (ContainerId root : tree.roots()) hostable = hostable || tree.can_host(root, level);
+
+            const HierarchicalPlacement p = tree.place(level);
+            EXPECT_EQ(p.admitted, hostable);
+            if (p.admitted) {
+                active.push_back(p.demand);
+                EXPECT_EQ(tree.level(p.container), static_cast<OduLevel>(static_cast<int>(level) + 1));
+                EXPECT_EQ(tree.demand_container(p.demand), p.container);
+            }
+        }
+        ASSERT_TRUE(tree.verify_summaries()) << "step " << step;
+    }
+    EXPECT_EQ(tree.demand_count(), active.size());
+}
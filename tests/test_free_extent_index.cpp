@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#include "otn/admission_policy.hpp"
+#include "otn/candidate.hpp"
+#include "otn/free_extent_index.hpp"
+#include "otn/fragmentation.hpp"
+#include "otn/odu.hpp"
+#include "otn/odu_mux.hpp"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace otn;
+
+namespace {
+
+// Slot map with each slot occupied with probability 1 / every
+SlotMap random_occupancy(std::mt19937_64& rng, std::size_t capacity, unsigned every) {
+    SlotMap occupancy(capacity);
+    for (std::size_t slot = 0; slot < capacity; ++slot) {
+        if (rng() % every == 0) occupancy.set_range(slot, 1);
+    }
+    return occupancy;
+}
+
+} // anonymous namespace
+
+TEST(FreeExtentIndexTest, FitQueriesPickTheirRuns) {
+    FreeExtentIndex index(16);
+
+    // Free runs [0,2), [3,7), [8,16)
+    index.allocate(2, 1);
+    index.allocate(7, 1);
+    EXPECT_EQ(index.extent_count(), 3u);
+    EXPECT_EQ(index.free_slots(), 14u);
+    EXPECT_EQ(index.largest_extent(), 8u);
+
+    EXPECT_EQ(index.first_fit(1), 0u);
+    EXPECT_EQ(index.first_fit(3), 3u);
+    EXPECT_EQ(index.best_fit(3), 3u);
+    EXPECT_EQ(index.best_fit(2), 0u);
+    EXPECT_EQ(index.worst_fit(1), 8u);
+    EXPECT_EQ(index.fit(ExtentFit::BEST, 5), 8u);
+    EXPECT_EQ(index.first_fit(9), FreeExtentIndex::npos);
+    EXPECT_EQ(index.worst_fit(9), FreeExtentIndex::npos);
+    EXPECT_EQ(index.best_fit(0), FreeExtentIndex::npos);
+
+    EXPECT_EQ(index.extent_at(5), (FreeExtent{3, 4}));
+    EXPECT_EQ(index.extent_at(7).offset, FreeExtentIndex::npos);
+    EXPECT_TRUE(index.range_free(9, 7));
+    EXPECT_FALSE(index.range_free(9, 8));
+}
+
+TEST(FreeExtentIndexTest, ReleaseCoalescesAndRejectsDoubleFree) {
+    FreeExtentIndex index(12);
+    index.allocate(0, 12);
+    EXPECT_EQ(index.extent_count(), 0u);
+    EXPECT_EQ(index.first_fit(1), FreeExtentIndex::npos);
+
+    index.release(2, 2);
+    index.release(6, 2);
+    EXPECT_EQ(index.extent_count(), 2u);
+
+    // Bridges both neighbours into one run
+    index.release(4, 2);
+    ASSERT_EQ(index.extent_count(), 1u);
+    EXPECT_EQ(index.extents()[0], (FreeExtent{2, 6}));
+
+    EXPECT_THROW(index.release(3, 2), std::runtime_error);
+    EXPECT_THROW(index.release(1, 2), std::runtime_error);
+    EXPECT_THROW(index.release(10, 3), std::runtime_error);
+    EXPECT_THROW(index.allocate(1, 2), std::runtime_error);
+    EXPECT_THROW(index.allocate(2, 0), std::runtime_error);
+    EXPECT_EQ(index.free_slots(), 6u);
+}
+
+TEST(FreeExtentIndexTest, MetricsMatchAnalyzeFragmentation) {
+    std::mt19937_64 rng(17);
+
+    for (int trial = 0; trial < 200; ++trial) {
+        const std::size_t capacity = 1 + rng() % 80;
+        const SlotMap occupancy = random_occupancy(rng, capacity, 1 + trial % 4);
+        const FreeExtentIndex index = FreeExtentIndex::from_occupancy(occupancy);
+
+        const FragmentationMetrics expected = analyze_fragmentation(occupancy);
+        const FragmentationMetrics actual = index.metrics();
+        EXPECT_EQ(actual.gap_count, expected.gap_count);
+        EXPECT_EQ(actual.total_gap_slots, expected.total_gap_slots);
+        EXPECT_EQ(actual.max_gap, expected.max_gap);
+        EXPECT_EQ(actual.span_slots, expected.span_slots);
+        EXPECT_DOUBLE_EQ(actual.utilization, expected.utilization);
+
+        EXPECT_EQ(index.free_slots(), capacity - occupancy.count());
+        for (std::size_t width = 1; width <= 6; ++width) {
+            EXPECT_EQ(index.first_fit(width), occupancy.find_first_fit(width));
+        }
+    }
+}
+
+TEST(FreeExtentIndexTest, ChurnBeyondSlotMapCapacity) {
+    constexpr std::size_t kCapacity = 10000;
+    FreeExtentIndex index(kCapacity);
+    std::vector<bool> used(kCapacity, false);
+
+    struct Held { std::size_t offset, width; };
+    std::vector<Held> held;
+    std::mt19937_64 rng(23);
+
+    for (int step = 0; step < 5000; ++step) {
+        if (!held.empty() && rng() % 3 == 0) {
+            const std::size_t i = rng() % held.size();
+            index.release(held[i].offset, held[i].width);
+            for (std::size_t s = 0; s < held[i].width; ++s) used[held[i].offset + s] = false;
+            held[i] = held.back();
+            held.pop_back();
+            continue;
+        }
+
+        const std::size_t width = 1 + rng() % 16;
+        const std::size_t offset = index.fit(static_cast<ExtentFit>(step % 3), width);
+        if (offset == FreeExtentIndex::npos) continue;
+        index.allocate(offset, width);
+        for (std::size_t s = 0; s < width; ++s) used[offset + s] = true;
+        held.push_back({offset, width});
+    }
+
+    // Runs rebuilt from the reference bitmap
+    std::vector<FreeExtent> expected;
+    for (std::size_t slot = 0; slot < kCapacity; ++slot) {
+        if (used[slot]) continue;
+        if (expected.empty() || expected.back().offset + expected.back().length != slot) {
+            expected.push_back({slot, 0});
+        }
+        ++expected.back().length;
+    }
+    EXPECT_EQ(index.extents(), expected);
+}
+
+TEST(FreeExtentIndexTest, IndexedPoliciesMatchFullScan) {
+    const Odu leaf(OduLevel::ODU1, {});
+    const Odu odu2(OduLevel::ODU2, {});
+    std::mt19937_64 rng(29);
+
+    for (int trial = 0; trial < 100; ++trial) {
+        std::vector<GroomedChild> grooming;
+        for (std::size_t slot = 0; slot < 80; ++slot) {
+            if (rng() % 4 == 0) grooming.emplace_back(&leaf, slot);
+        }
+        const AdmissionEngine engine(OduLevel::ODU4, grooming);
+        const AdmissionEngine unindexed(OduLevel::ODU4, grooming, false);
+        EXPECT_EQ(unindexed.extents().extent_count(), 0u);
+
+        for (CostPolicyKind kind : {CostPolicyKind::BEST_FIT, CostPolicyKind::EXACT_FIT, CostPolicyKind::WORST_FIT}) {
+            EXPECT_TRUE(cost_policy_picks(kind));
+            for (const Odu* child : {&leaf, &odu2}) {
+                // CostPolicy has no pick(), so it scans every feasible offset
+                const AdmissionResult scanned = engine.best_placement(*child, make_cost_policy(kind));
+                const AdmissionResult indexed = dispatch_cost_policy(kind, {}, [&](const auto& policy) {
+                    return engine.best_placement(*child, policy);
+                });
+                // Without the index the same policy falls back to the scan
+                const AdmissionResult fallback = dispatch_cost_policy(kind, {}, [&](const auto& policy) {
+                    return unindexed.best_placement(*child, policy);
+                });
+                EXPECT_EQ(indexed.admitted, scanned.admitted) << to_string(kind);
+                EXPECT_EQ(indexed.chosen_offset, scanned.chosen_offset) << to_string(kind);
+                EXPECT_EQ(fallback.admitted, scanned.admitted) << to_string(kind);
+                EXPECT_EQ(fallback.chosen_offset, scanned.chosen_offset) << to_string(kind);
+            }
+        }
+        EXPECT_FALSE(cost_policy_picks(CostPolicyKind::MIN_FRAGMENTATION));
+    }
+}
+
+TEST(FreeExtentIndexTest, OduMuxFitStrategies) {
+    std::vector<Odu> clients(4, Odu(OduLevel::ODU1, 100));
+
+    // Fills an ODU2, frees the given clients and re-adds the first of them
+    auto refill = [&](ExtentFit fit, std::vector<std::size_t> freed) {
+        OduMux mux(OduLevel::ODU2, fit);
+        for (const Odu& c : clients) EXPECT_EQ(mux.add_client(c).status, MuxStatus::SUCCESS);
+        for (std::size_t i : freed) mux.remove_client(clients[i]);
+        EXPECT_EQ(mux.add_client(clients[freed[0]]).status, MuxStatus::SUCCESS);
+        return mux.grooming().back().slot_offset;
+    };
+
+    // Free runs [0,2) and [3,4)
+    EXPECT_EQ(refill(ExtentFit::FIRST, {0, 1, 3}), 0u);
+    EXPECT_EQ(refill(ExtentFit::BEST, {0, 1, 3}), 3u);
+
+    // Free runs [0,1) and [2,4)
+    EXPECT_EQ(refill(ExtentFit::FIRST, {0, 2, 3}), 0u);
+    EXPECT_EQ(refill(ExtentFit::WORST, {0, 2, 3}), 2u);
+
+    OduMux mux(OduLevel::ODU2, ExtentFit::WORST);
+    mux.add_client(clients[0]);
+    mux.reset();
+    EXPECT_EQ(mux.add_client(clients[1]).status, MuxStatus::SUCCESS);
+    EXPECT_EQ(mux.grooming().back().slot_offset, 0u);
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include "otn/instrumentation.hpp"
+#include "otn/candidate.hpp"
+#include "otn/fragmentation.hpp"
+#include "otn/grooming_planner.hpp"
+#include "otn/odu.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace otn;
+
+// ---------------- Histogram ----------------
+
+TEST(InstrumentationTest, HistogramQuantilesUseLog2Buckets) {
+    instr::Histogram h;
+    EXPECT_EQ(h.quantile_ns(0.5), 0u);
+    EXPECT_EQ(h.mean_ns(), 0.0);
+
+    // 90 samples in [64, 128), 10 in [4096, 8192)
+    h.buckets[6] = 90;
+    h.buckets[12] = 10;
+    h.count = 100;
+    h.sum_ns = 90 * 100 + 10 * 5000;
+    h.max_ns = 5000;
+
+    EXPECT_EQ(h.quantile_ns(0.5), 127u);
+    EXPECT_EQ(h.quantile_ns(0.99), 5000u);   // capped by the observed max
+    EXPECT_DOUBLE_EQ(h.mean_ns(), 590.0);
+}
+
+TEST(InstrumentationTest, DumpsNameEveryMetric) {
+    const instr::Snapshot s = instr::snapshot();
+    const std::string json = instr::to_json(s);
+    const std::string prom = instr::to_prometheus(s);
+
+    EXPECT_NE(json.find("\"feasible_offsets_empty\""), std::string::npos);
+    EXPECT_NE(json.find("\"admission\": {\"count\""), std::string::npos);
+    EXPECT_NE(prom.find("# TYPE otn_candidates_rejected_total counter"), std::string::npos);
+    EXPECT_NE(prom.find("otn_repack_seconds_bucket{le=\"+Inf\"}"), std::string::npos);
+}
+
+#if OTN_INSTRUMENTATION
+
+// ---------------- Wired probes ----------------
+
+// Times every call for the duration of a test
+class FullTimerSampling {
+public:
+    FullTimerSampling() : saved_(instr::timer_sample_period()) {
+        instr::set_timer_sample_period(1);
+    }
+    ~FullTimerSampling() { instr::set_timer_sample_period(saved_); }
+
+private:
+    uint32_t saved_;
+};
+
+TEST(InstrumentationTest, CountsFeasibilityQueries) {
+    Odu a(OduLevel::ODU1, 100);
+    Odu candidate(OduLevel::ODU1, 100);
+    std::vector<GroomedChild> full = {
+        GroomedChild(&a, 0), GroomedChild(&a, 1), GroomedChild(&a, 2), GroomedChild(&a, 3)
+    };
+
+    FullTimerSampling sampling;
+    instr::reset();
+    feasible_offsets(OduLevel::ODU2, {}, candidate);
+    feasible_offsets(OduLevel::ODU2, full, candidate);
+    const instr::Snapshot s = instr::snapshot();
+
+    EXPECT_EQ(s.counter(instr::Counter::FEASIBLE_OFFSETS), 2u);
+    EXPECT_EQ(s.counter(instr::Counter::FEASIBLE_OFFSETS_EMPTY), 1u);
+    EXPECT_EQ(s.timer(instr::Timer::FEASIBLE_OFFSETS).count, 2u);
+}
+
+TEST(InstrumentationTest, CountsAdmissionOutcomes) {
+    Odu x(OduLevel::ODU1, 100);
+    Odu y(OduLevel::ODU1, 100);
+    std::vector<Candidate> candidates = {
+        {&x, 0, 0.0}, {&x, 9, 0.0},   // offset 9 is outside an ODU2
+        {&y, 0, 0.0}                  // blocked: x takes slot 0 first
+    };
+
+    FullTimerSampling sampling;
+    instr::reset();
+    admit_candidates(OduLevel::ODU2, {}, candidates);
+    const instr::Snapshot s = instr::snapshot();
+
+    EXPECT_EQ(s.counter(instr::Counter::ADMISSION_EVALUATIONS), 2u);
+    EXPECT_EQ(s.counter(instr::Counter::CANDIDATES_CONSIDERED), 3u);
+    EXPECT_EQ(s.counter(instr::Counter::CANDIDATES_REJECTED), 2u);
+    EXPECT_EQ(s.counter(instr::Counter::ADMISSIONS_ACCEPTED), 1u);
+    EXPECT_EQ(s.counter(instr::Counter::ADMISSIONS_BLOCKED), 1u);
+    EXPECT_EQ(s.timer(instr::Timer::ADMISSION).count, 2u);
+}
+
+TEST(InstrumentationTest, CountsRepackAndMuxFailures) {
+    Odu a(OduLevel::ODU1, 100);
+    std::vector<GroomedChild> too_wide = {GroomedChild(&a, 3, 0), GroomedChild(&a, 2, 3)};
+    std::vector<GroomedChild> out;
+    Odu parent(OduLevel::ODU2, 0);
+
+    instr::reset();
+    try_repack_grooming_size_aware(OduLevel::ODU2, too_wide, out);
+    mux(OduLevel::ODU2, {GroomedChild(&a, 0), GroomedChild(&a, 0)}, parent);
+    const instr::Snapshot s = instr::snapshot();
+
+    EXPECT_EQ(s.counter(instr::Counter::REPACK), 1u);
+    EXPECT_EQ(s.counter(instr::Counter::REPACK_BLOCKED), 1u);
+    EXPECT_EQ(s.counter(instr::Counter::MUX_CALLS), 1u);
+    EXPECT_EQ(s.counter(instr::Counter::MUX_FAILURES), 1u);
+    EXPECT_EQ(s.counter(instr::Counter::ODU_AGGREGATIONS_FAILED), 1u);
+}
+
+TEST(InstrumentationTest, SamplesTimersButCountsEveryCall) {
+    Odu candidate(OduLevel::ODU1, 100);
+    instr::set_timer_sample_period(4);
+
+    instr::reset();
+    for (int i = 0; i < 16; ++i) feasible_offsets(OduLevel::ODU2, {}, candidate);
+    const instr::Snapshot s = instr::snapshot();
+    instr::set_timer_sample_period(instr::kDefaultTimerSamplePeriod);
+
+    EXPECT_EQ(s.counter(instr::Counter::FEASIBLE_OFFSETS), 16u);
+    EXPECT_EQ(s.timer(instr::Timer::FEASIBLE_OFFSETS).count, 4u);
+}
+
+TEST(InstrumentationTest, KeepsCountsOfExitedThreads) {
+    instr::reset();
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([] {
+            for (int i = 0; i < 1000; ++i) instr::add(instr::Counter::REPACK_OPTIMAL_NODES);
+            instr::record(instr::Timer::REPACK_OPTIMAL, 300);
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    const instr::Snapshot s = instr::snapshot();
+    EXPECT_EQ(s.counter(instr::Counter::REPACK_OPTIMAL_NODES), 4000u);
+    EXPECT_EQ(s.timer(instr::Timer::REPACK_OPTIMAL).count, 4u);
+    EXPECT_EQ(s.timer(instr::Timer::REPACK_OPTIMAL).buckets[8], 4u);
+}
+
+// Destroyed after the thread's instrumentation slot, since it was built first
+struct CountsOnThreadExit {
+    ~CountsOnThreadExit() {
+        instr::add(instr::Counter::REPACK_OPTIMAL_NODES);
+        instr::record(instr::Timer::REPACK_OPTIMAL, 300);
+    }
+};
+
+TEST(InstrumentationTest, DropsSamplesAfterThreadSlotIsGone) {
+    instr::reset();
+
+    std::thread([] {
+        thread_local CountsOnThreadExit late;
+        (void)late;
+        instr::add(instr::Counter::REPACK_OPTIMAL_NODES);
+    }).join();
+
+    const instr::Snapshot s = instr::snapshot();
+    EXPECT_EQ(s.counter(instr::Counter::REPACK_OPTIMAL_NODES), 1u);
+    EXPECT_EQ(s.timer(instr::Timer::REPACK_OPTIMAL).count, 0u);
+}
+
+#endif
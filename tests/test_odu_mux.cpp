@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "otn/odu_mux.hpp"
+#include "otn/odu.hpp"
+
+#include <vector>
+
+using namespace otn;
+
+// ---------------- OduMux ----------------
+
+TEST(OduMuxTest, AddsClientsFirstFit) {
+    Odu a(OduLevel::ODU1, 100);
+    Odu b(OduLevel::ODU1, 200);
+
+    OduMux mux(OduLevel::ODU2);
+
+    ASSERT_EQ(mux.add_client(a).status, MuxStatus::SUCCESS);
+    ASSERT_EQ(mux.add_client(b).status, MuxStatus::SUCCESS);
+
+    EXPECT_EQ(mux.client_count(), 2u);
+    EXPECT_EQ(mux.used_capacity(), 2u);
+    EXPECT_EQ(mux.remaining_capacity(), 2u);
+    EXPECT_EQ(mux.grooming()[1].slot_offset, 1u);
+
+    Odu parent = mux.multiplex();
+    EXPECT_EQ(parent.level(), OduLevel::ODU2);
+    EXPECT_EQ(parent.payload_size(), 300u);
+    EXPECT_EQ(parent.slots(), 2u);
+    EXPECT_EQ(parent.leaf_count(), 2u);
+}
+
+TEST(OduMuxTest, RejectsWrongLevelDuplicatesAndOverflow) {
+    Odu wrong(OduLevel::ODU2, 100);
+    Odu big(OduLevel::ODU3, 100);
+
+    OduMux mux(OduLevel::ODU4);
+
+    EXPECT_FALSE(mux.can_accept(wrong));
+    EXPECT_EQ(mux.add_client(wrong).status, MuxStatus::INVALID_HIERARCHY);
+
+    // 5 x 16 slots fill an ODU4 exactly
+    std::vector<Odu> fill(5, Odu(OduLevel::ODU3, 100));
+    for (const auto& c : fill) {
+        ASSERT_EQ(mux.add_client(c).status, MuxStatus::SUCCESS);
+    }
+    EXPECT_TRUE(mux.is_full());
+    EXPECT_FALSE(mux.can_accept(big));
+    EXPECT_EQ(mux.add_client(big).status, MuxStatus::INSUFFICIENT_CAPACITY);
+    EXPECT_EQ(mux.add_client(fill[0]).status, MuxStatus::INVALID_HIERARCHY);
+}
+
+TEST(OduMuxTest, RemovalFreesSlotsForReuse) {
+    Odu a(OduLevel::ODU1, 100);
+    Odu b(OduLevel::ODU1, 100);
+    Odu c(OduLevel::ODU1, 100);
+
+    OduMux mux(OduLevel::ODU2);
+    mux.add_client(a);
+    mux.add_client(b);
+    mux.add_client(c);
+
+    ASSERT_EQ(mux.remove_client(a).status, MuxStatus::SUCCESS);
+    EXPECT_EQ(mux.remove_client(a).status, MuxStatus::INVALID_HIERARCHY);
+    EXPECT_EQ(mux.client_count(), 2u);
+    EXPECT_EQ(mux.used_capacity(), 2u);
+
+    // Slot 0 is free again and is handed out first
+    Odu d(OduLevel::ODU1, 100);
+    ASSERT_EQ(mux.add_client(d).status, MuxStatus::SUCCESS);
+    EXPECT_EQ(mux.grooming().back().slot_offset, 0u);
+
+    // Multiplexed result is a valid grooming
+    Odu parent = mux.multiplex();
+    EXPECT_NO_THROW(Odu(OduLevel::ODU2, parent.groomed_children()));
+}
+
+TEST(OduMuxTest, ResetClearsEverything) {
+    Odu a(OduLevel::ODU1, 100);
+
+    OduMux mux(OduLevel::ODU2);
+    mux.add_client(a);
+    mux.reset();
+
+    EXPECT_EQ(mux.client_count(), 0u);
+    EXPECT_EQ(mux.used_capacity(), 0u);
+    EXPECT_TRUE(mux.can_accept(a));
+    EXPECT_THROW(mux.multiplex(), std::runtime_error);
+}
+
+TEST(OduMuxTest, RemovalSubtractsPayloadAsAdded) {
+    Odu leaf(OduLevel::ODU1, 100);
+    Odu aggregate(OduLevel::ODU2, {GroomedChild(&leaf, 0)});
+    Odu other(OduLevel::ODU2, 50);
+
+    OduMux mux(OduLevel::ODU3);
+    mux.add_client(aggregate);
+    mux.add_client(other);
+
+    // The client's payload grows after it was added
+    leaf = Odu(OduLevel::ODU1, 1000);
+    aggregate.refresh_summary();
+    ASSERT_EQ(aggregate.payload_size(), 1000u);
+
+    ASSERT_EQ(mux.remove_client(aggregate).status, MuxStatus::SUCCESS);
+    EXPECT_EQ(mux.multiplex().payload_size(), 50u);
+}
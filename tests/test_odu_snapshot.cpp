@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include "otn/odu_snapshot.hpp"
+#include "otn/odu_store.hpp"
+
+#include "temp_file.hpp"
+
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace otn;
+
+namespace {
+
+using otn::test::TempFile;
+
+// ODU1 leaves under ODU2 aggregates under one ODU3, plus a loose leaf
+OduStore make_store() {
+    OduStore store;
+    std::vector<ChildPlacement> odu2s;
+
+    for (std::size_t p = 0; p < 3; ++p) {
+        std::vector<ChildPlacement> leaves;
+        for (std::size_t i = 0; i < 4; ++i) {
+            leaves.push_back({store.add_leaf(OduLevel::ODU1, 100 * (p + 1) + i), i});
+        }
+        odu2s.push_back({store.add_aggregate(OduLevel::ODU2, leaves), 4 * p + 4});
+    }
+    store.add_aggregate(OduLevel::ODU3, odu2s);
+    store.add_leaf(OduLevel::ODU4, 12345);
+    return store;
+}
+
+void overwrite(const std::string& path, std::size_t offset, const void* bytes, std::size_t n) {
+    std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+    f.seekp(static_cast<std::streamoff>(offset));
+    f.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(n));
+}
+
+} // anonymous namespace
+
+// ---------------- Layout ----------------
+
+TEST(OduSnapshotTest, LayoutAlignsEverySection) {
+    const SnapshotHeader h = snapshot_layout(5, 3);
+
+    EXPECT_EQ(h.version, kSnapshotVersion);
+    EXPECT_EQ(h.payload_bytes_offset, 88u);
+    EXPECT_EQ(h.children_offset, 88u + 40u);
+    EXPECT_EQ(h.first_child_offset, 128u + 24u);
+    EXPECT_EQ(h.level_offset, 152u + 24u);    // 20 bytes rounded up
+    EXPECT_EQ(h.slot_count_offset, 176u + 8u);
+    EXPECT_EQ(h.child_count_offset, 184u + 8u);
+    EXPECT_EQ(h.file_bytes, 192u + 8u);
+}
+
+// ---------------- Round trip ----------------
+
+TEST(OduSnapshotTest, MappedViewMatchesStore) {
+    const OduStore store = make_store();
+    TempFile file("otn_snapshot_view.bin");
+    store.save(file.path());
+
+    MappedSnapshot snap(file.path());
+    snap.verify();
+
+    ASSERT_EQ(snap.size(), store.size());
+    EXPECT_EQ(snap.child_link_count(), store.child_link_count());
+    EXPECT_EQ(snap.file_bytes(), snapshot_layout(store.size(), store.child_link_count()).file_bytes);
+
+    for (std::uint32_t i = 0; i < store.size(); ++i) {
+        const OduHandle h{i};
+        EXPECT_EQ(snap.level(h), store.level(h));
+        EXPECT_EQ(snap.payload_size(h), store.payload_size(h));
+        EXPECT_EQ(snap.slots(h), store.slots(h));
+        ASSERT_EQ(snap.children(h).size(), store.children(h).size());
+
+        auto a = snap.children(h).begin();
+        for (const StoredChild& c : store.children(h)) {
+            EXPECT_EQ(a->child, c.child);
+            EXPECT_EQ(a->slot_offset, c.slot_offset);
+            EXPECT_EQ(a->slot_width, c.slot_width);
+            ++a;
+        }
+    }
+}
+
+TEST(OduSnapshotTest, LoadRestoresMutableStore) {
+    TempFile file("otn_snapshot_load.bin");
+    make_store().save(file.path());
+
+    OduStore store = OduStore::load(file.path());
+    const OduHandle top{15};
+    EXPECT_EQ(store.level(top), OduLevel::ODU3);
+    EXPECT_EQ(store.slots(top), 12u);
+    EXPECT_EQ(store.payload_size(top), 400u + 6u + 800u + 6u + 1200u + 6u);
+
+    // Handles continue where the snapshot ended
+    const OduHandle extra = store.add_leaf(OduLevel::ODU1, 1);
+    EXPECT_EQ(extra.index, 17u);
+    store.add_aggregate(OduLevel::ODU2, {{extra, 3}});
+}
+
+TEST(OduSnapshotTest, EmptyStoreRoundTrips) {
+    TempFile file("otn_snapshot_empty.bin");
+    OduStore().save(file.path());
+
+    MappedSnapshot snap(file.path());
+    EXPECT_EQ(snap.size(), 0u);
+    snap.verify();
+    EXPECT_EQ(OduStore::load(snap).size(), 0u);
+}
+
+TEST(OduSnapshotTest, MoveTransfersMapping) {
+    TempFile file("otn_snapshot_move.bin");
+    make_store().save(file.path());
+
+    MappedSnapshot a(file.path());
+    MappedSnapshot b(std::move(a));
+    EXPECT_EQ(a.size(), 0u);
+    EXPECT_EQ(b.size(), 17u);
+    EXPECT_EQ(b.level(OduHandle{16}), OduLevel::ODU4);
+}
+
+// ---------------- Rejection ----------------
+
+TEST(OduSnapshotTest, RejectsMalformedHeaders) {
+    TempFile file("otn_snapshot_bad.bin");
+    EXPECT_THROW(MappedSnapshot(file.path()), std::runtime_error);   // missing
+
+    std::ostringstream bytes;
+    make_store().save(bytes);
+    const std::string good = bytes.str();
+
+    auto expect_reject = [&](std::size_t offset, const void* patch, std::size_t n) {
+        std::ofstream(file.path(), std::ios::binary) << good;
+        overwrite(file.path(), offset, patch, n);
+        EXPECT_THROW(MappedSnapshot(file.path()), std::runtime_error);
+    };
+
+    expect_reject(0, "XTN", 3);
+    const std::uint32_t version = kSnapshotVersion + 1;
+    expect_reject(offsetof(SnapshotHeader, version), &version, sizeof(version));
+    const std::uint64_t odus = 3;
+    expect_reject(offsetof(SnapshotHeader, odu_count), &odus, sizeof(odus));
+
+    // Truncated file
+    std::ofstream(file.path(), std::ios::binary) << good.substr(0, good.size() - 8);
+    EXPECT_THROW(MappedSnapshot(file.path()), std::runtime_error);
+}
+
+TEST(OduSnapshotTest, VerifyCatchesCorruptGrooming) {
+    TempFile file("otn_snapshot_corrupt.bin");
+    const OduStore store = make_store();
+    store.save(file.path());
+
+    // Second child of the first ODU2 moved onto the first one's slot
+    const SnapshotHeader h = snapshot_layout(store.size(), store.child_link_count());
+    const std::uint16_t offset = 0;
+    overwrite(file.path(),
+              h.children_offset + sizeof(StoredChild) + offsetof(StoredChild, slot_offset),
+              &offset, sizeof(offset));
+
+    MappedSnapshot snap(file.path());   // header is still valid
+    EXPECT_THROW(snap.verify(), std::runtime_error);
+
+    // The mutable store never takes an unverified file
+    EXPECT_THROW(OduStore::load(snap), std::runtime_error);
+    EXPECT_THROW(OduStore::load(file.path()), std::runtime_error);
+}
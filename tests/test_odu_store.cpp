@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include "otn/odu_store.hpp"
+#include "otn/odu.hpp"
+
+#include <vector>
+
+using namespace otn;
+
+// ---------------- OduStore ----------------
+
+TEST(OduStoreTest, LeavesAndAggregatesMatchOduModel) {
+    OduStore store;
+
+    OduHandle a = store.add_leaf(OduLevel::ODU1, 100);
+    OduHandle b = store.add_leaf(OduLevel::ODU1, 150);
+    OduHandle parent = store.add_aggregate(OduLevel::ODU2, {
+        {a, 0},
+        {b, 1}
+    });
+
+    EXPECT_EQ(store.size(), 3u);
+    EXPECT_FALSE(store.is_aggregated(a));
+    EXPECT_TRUE(store.is_aggregated(parent));
+    EXPECT_EQ(store.level(parent), OduLevel::ODU2);
+    EXPECT_EQ(store.payload_size(parent), 250u);
+    EXPECT_EQ(store.slots(parent), 2u);
+
+    auto children = store.children(parent);
+    ASSERT_EQ(children.size(), 2u);
+    EXPECT_EQ(children.begin()[0].child, a);
+    EXPECT_EQ(children.begin()[1].slot_offset, 1u);
+}
+
+TEST(OduStoreTest, HandlesSurviveGrowth) {
+    OduStore store;
+    OduHandle first = store.add_leaf(OduLevel::ODU1, 42);
+
+    for (int i = 0; i < 10000; ++i) {
+        store.add_leaf(OduLevel::ODU1, 1);
+    }
+
+    EXPECT_EQ(store.payload_size(first), 42u);
+}
+
+TEST(OduStoreTest, RejectsInvalidGrooming) {
+    OduStore store;
+    OduHandle a = store.add_leaf(OduLevel::ODU1, 100);
+    OduHandle b = store.add_leaf(OduLevel::ODU1, 100);
+
+    EXPECT_THROW(store.add_aggregate(OduLevel::ODU2, {{a, 0}, {b, 0}}), std::runtime_error);
+    EXPECT_THROW(store.add_aggregate(OduLevel::ODU2, {{a, 4}}), std::runtime_error);
+    EXPECT_THROW(store.add_aggregate(OduLevel::ODU3, {{a, 0}}), std::runtime_error);
+    EXPECT_THROW(store.add_aggregate(OduLevel::ODU2, {{OduHandle{99}, 0}}), std::runtime_error);
+    EXPECT_THROW(store.add_leaf(OduLevel::ODU1, nominal_capacity(OduLevel::ODU1) + 1),
+                 std::runtime_error);
+
+    // Empty aggregates take no slots, so they could be stacked past the 8-bit child count
+    const OduHandle empty = store.add_aggregate(OduLevel::ODU2, {});
+    EXPECT_EQ(store.slots(empty), 0u);
+    EXPECT_THROW(store.add_aggregate(OduLevel::ODU3, {{empty, 0}}), std::runtime_error);
+    const std::vector<ChildPlacement> crowd(256, ChildPlacement{empty, 0});
+    EXPECT_THROW(store.add_aggregate(OduLevel::ODU3, crowd), std::runtime_error);
+
+    // Failed aggregates leave nothing behind
+    EXPECT_EQ(store.size(), 3u);
+    EXPECT_EQ(store.child_link_count(), 0u);
+}
+
+TEST(OduStoreTest, ImportCopiesNestedHierarchy) {
+    Odu leaf1(OduLevel::ODU1, 100);
+    Odu leaf2(OduLevel::ODU1, 200);
+    Odu mid(OduLevel::ODU2, {
+        GroomedChild(&leaf1, leaf1.slots(), 0),
+        GroomedChild(&leaf2, leaf2.slots(), 1)
+    });
+    Odu top(OduLevel::ODU3, {
+        GroomedChild(&mid, mid.slots(), 4)
+    });
+
+    OduStore store;
+    OduHandle h = store.import(top);
+
+    EXPECT_EQ(store.size(), 4u);
+    EXPECT_EQ(store.payload_size(h), 300u);
+
+    auto top_children = store.children(h);
+    ASSERT_EQ(top_children.size(), 1u);
+    EXPECT_EQ(top_children.begin()->slot_offset, 4u);
+    EXPECT_EQ(store.children(top_children.begin()->child).size(), 2u);
+}
+
+TEST(OduStoreTest, ClearDropsEverything) {
+    OduStore store;
+    OduHandle a = store.add_leaf(OduLevel::ODU1, 100);
+    store.add_aggregate(OduLevel::ODU2, {{a, 0}});
+
+    store.clear();
+
+    EXPECT_EQ(store.size(), 0u);
+    EXPECT_EQ(store.child_link_count(), 0u);
+}
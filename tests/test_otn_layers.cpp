@@ -5,6 +5,7 @@
 #include "otn/odu.hpp"
 #include "otn/otu.hpp"
 #include "otn/fragmentation.hpp"
+#include "otn/defragmentation.hpp"
 #include "otn/grooming_planner.hpp"
 
 using namespace otn;
@@ -16,6 +17,25 @@ TEST(PayloadTest, SizeIsCorrect) {
     EXPECT_EQ(p.size(), 1000);
 }
 
+TEST(PayloadTest, SizeOnlyPayloadHasNoBytes) {
+    Payload p(100000);
+    EXPECT_EQ(p.size(), 100000u);
+    EXPECT_FALSE(p.has_bytes());
+    EXPECT_EQ(p.data(), nullptr);
+}
+
+TEST(PayloadTest, SharedBufferIsNotCopied) {
+    Payload p = Payload::zero_filled(64);
+    Payload copy = p;
+    Opu opu(copy);
+
+    ASSERT_TRUE(p.has_bytes());
+    EXPECT_EQ(p.size(), 64u);
+    EXPECT_EQ(copy.data(), p.data());
+    EXPECT_EQ(opu.payload().data(), p.data());
+    EXPECT_EQ(p.buffer().use_count(), 3);
+}
+
 // ---------------- OPU ----------------
 
 TEST(OpuTest, PayloadPassThrough) {
@@ -60,6 +80,15 @@ TEST(OtuTest, OtuWrapsOduCorrectly) {
     EXPECT_EQ(otu.odu_level(), OduLevel::ODU2);
 }
 
+TEST(OtuTest, SharedOduIsNotCopied) {
+    auto odu = std::make_shared<const Odu>(OduLevel::ODU4, 1000);
+    Otu otu(odu, false);
+    Otu copy = otu;
+
+    EXPECT_EQ(&otu.odu(), odu.get());
+    EXPECT_EQ(&copy.odu(), odu.get());
+    EXPECT_EQ(copy.payload_size(), 1000u);
+}
 
 TEST(OduTest, CanConstructFromOpu) {
     Payload p(400);
@@ -88,6 +117,71 @@ TEST(OduTest, NestedAggregationSumsCorrectly) {
     EXPECT_TRUE(top.is_aggregated());
 }
 
+// ---------------- Subtree summary tests ----------------
+TEST(OduTest, SubtreeSummaryIsCachedPerNode) {
+    Odu leaf1(OduLevel::ODU1, 100);
+    Odu leaf2(OduLevel::ODU1, 200);
+    Odu leaf3(OduLevel::ODU2, 1000);
+
+    Odu mid(OduLevel::ODU2, {
+        GroomedChild(&leaf1, leaf1.slots(), 0),
+        GroomedChild(&leaf2, leaf2.slots(), 1)
+    });
+    Odu top(OduLevel::ODU3, {
+        GroomedChild(&mid, mid.slots(), 0),
+        GroomedChild(&leaf3, leaf3.slots(), 4)
+    });
+
+    EXPECT_EQ(leaf1.leaf_count(), 1u);
+    EXPECT_EQ(leaf1.depth(), 0u);
+
+    const SubtreeSummary& s = top.summary();
+    EXPECT_EQ(s.leaf_count, 3u);
+    EXPECT_EQ(s.depth, 2u);
+    EXPECT_EQ(s.leaf_payload_bytes, 1300u);
+    EXPECT_EQ(s.leaves_per_level[1], 2u);
+    EXPECT_EQ(s.leaves_per_level[2], 1u);
+
+    const SubtreeSummary walked = Odu::compute_summary(top);
+    EXPECT_EQ(walked.leaf_count, s.leaf_count);
+    EXPECT_EQ(walked.depth, s.depth);
+    EXPECT_EQ(walked.leaf_payload_bytes, s.leaf_payload_bytes);
+    EXPECT_EQ(walked.leaves_per_level, s.leaves_per_level);
+}
+
+TEST(OduTest, RefreshSummaryPicksUpChangedChildren) {
+    Odu leaf1(OduLevel::ODU1, 100);
+
+    Odu mid(OduLevel::ODU2, {
+        GroomedChild(&leaf1, leaf1.slots(), 0)
+    });
+    Odu top(OduLevel::ODU3, {
+        GroomedChild(&mid, mid.slots(), 0)
+    });
+
+    // Child replaced in place: caches are stale until refreshed bottom-up
+    leaf1 = Odu(OduLevel::ODU1, 500);
+    EXPECT_EQ(top.summary().leaf_payload_bytes, 100u);
+
+    mid.refresh_summary();
+    top.refresh_summary();
+
+    EXPECT_EQ(top.summary().leaf_payload_bytes, 500u);
+    EXPECT_EQ(top.payload_size(), 500u);
+
+    // A regroomed child can change its slot total too
+    Odu leaf2(OduLevel::ODU1, 200);
+    mid = Odu(OduLevel::ODU2, {
+        GroomedChild(&leaf1, leaf1.slots(), 0),
+        GroomedChild(&leaf2, leaf2.slots(), 1)
+    });
+    top.refresh_summary();
+
+    EXPECT_EQ(top.slots(), 2u);
+    EXPECT_EQ(top.payload_size(), 700u);
+    EXPECT_EQ(top.leaf_count(), 2u);
+}
+
 // ---------------- Aggregated ODU test ----------------
 TEST(OduTest, AggregatedOduIsNotLeaf) {
     Odu child(OduLevel::ODU1, 100);
@@ -255,6 +349,73 @@ TEST(FragmentationTest, MetricsAreComputedCorrectly) {
     EXPECT_LT(m.utilization, 1.0);
 }
 
+// ---------------- Incremental fragmentation state ----------------
+
+static void expect_same_metrics(
+    const FragmentationMetrics& a,
+    const FragmentationMetrics& b
+) {
+    EXPECT_EQ(a.gap_count, b.gap_count);
+    EXPECT_EQ(a.total_gap_slots, b.total_gap_slots);
+    EXPECT_EQ(a.max_gap, b.max_gap);
+    EXPECT_EQ(a.span_slots, b.span_slots);
+    EXPECT_DOUBLE_EQ(a.utilization, b.utilization);
+}
+
+TEST(FragmentationTest, IncrementalStateTracksInsertAndRemove) {
+    Odu c1(OduLevel::ODU1, 100);
+    Odu c2(OduLevel::ODU1, 100);
+    Odu c3(OduLevel::ODU1, 100);
+
+    std::vector<GroomedChild> grooming = {
+        GroomedChild(&c1, c1.slots(), 0),
+        GroomedChild(&c2, c2.slots(), 2),
+        GroomedChild(&c3, c3.slots(), 4)
+    };
+
+    FragmentationState state(grooming);
+    expect_same_metrics(state.metrics(), analyze_fragmentation(grooming));
+
+    // Remove the middle child: the two unit gaps merge into one of 3
+    state.remove(2, 1);
+    grooming.erase(grooming.begin() + 1);
+    expect_same_metrics(state.metrics(), analyze_fragmentation(grooming));
+    EXPECT_EQ(state.metrics().max_gap, 3u);
+
+    // Remove the first child: span collapses to the remaining one
+    state.remove(0, 1);
+    grooming.erase(grooming.begin());
+    expect_same_metrics(state.metrics(), analyze_fragmentation(grooming));
+
+    state.remove(4, 1);
+    EXPECT_EQ(state.metrics().span_slots, 0u);
+}
+
+TEST(FragmentationTest, WhatIfMatchesFullAnalysisWithoutMutating) {
+    Odu leaf(OduLevel::ODU1, 100);
+
+    std::vector<GroomedChild> grooming = {
+        GroomedChild(&leaf, 4, 0),
+        GroomedChild(&leaf, 1, 9),
+        GroomedChild(&leaf, 2, 20)
+    };
+
+    FragmentationState state(grooming);
+    const auto before = state.metrics();
+
+    for (std::size_t offset : {4u, 5u, 8u, 10u, 15u, 19u, 22u, 30u}) {
+        std::vector<GroomedChild> trial = grooming;
+        trial.emplace_back(&leaf, 1, offset);
+
+        expect_same_metrics(
+            state.what_if(offset, 1),
+            analyze_fragmentation(trial)
+        );
+    }
+
+    expect_same_metrics(state.metrics(), before);
+    EXPECT_THROW(state.what_if(1, 1), std::runtime_error);
+}
 
 TEST(GroomingPlannerTest, SizeAwareRepackProducesValidGrooming) {
     Odu small(OduLevel::ODU1, 100);
@@ -429,3 +590,284 @@ TEST(GroomingPlannerTest, OccupiedSlotsDetectsOverflow) {
         std::runtime_error
     );
 }
+
+TEST(GroomingPlannerTest, FeasibleOffsetMaskMatchesOffsets) {
+    Odu a(OduLevel::ODU2, 100);
+    Odu b(OduLevel::ODU2, 100);
+    Odu candidate(OduLevel::ODU2, 100);
+
+    std::vector<GroomedChild> grooming = {
+        GroomedChild(&a, 4, 2),
+        GroomedChild(&b, 4, 12)
+    };
+
+    // Free slots 0-1 and 6-11: a 4-slot child fits at 6, 7 and 8
+    const SlotMap mask = feasible_offset_mask(OduLevel::ODU3, grooming, candidate);
+    EXPECT_EQ(mask.to_offsets(), (std::vector<std::size_t>{6, 7, 8}));
+    EXPECT_EQ(mask.to_offsets(), feasible_offsets(OduLevel::ODU3, grooming, candidate));
+}
+
+// ---------------- Exact repack ----------------
+
+TEST(FragmentationTest, SlotMapAnalysisMatchesGroomingAnalysis) {
+    Odu leaf(OduLevel::ODU1, 100);
+
+    std::vector<GroomedChild> grooming = {
+        GroomedChild(&leaf, 4, 2),
+        GroomedChild(&leaf, 1, 9),
+        GroomedChild(&leaf, 16, 60)
+    };
+
+    expect_same_metrics(
+        analyze_fragmentation(occupied_slot_map(OduLevel::ODU4, grooming)),
+        analyze_fragmentation(grooming)
+    );
+}
+
+TEST(GroomingPlannerTest, OptimalRepackIsProvenAndCompact) {
+    Odu a(OduLevel::ODU1, 100);
+    Odu b(OduLevel::ODU1, 300);
+    Odu c(OduLevel::ODU1, 200);
+
+    std::vector<GroomedChild> fragmented = {
+        GroomedChild(&a, 4, 70),
+        GroomedChild(&b, 16, 20),
+        GroomedChild(&c, 1, 3)
+    };
+
+    auto report = repack_grooming_optimal(OduLevel::ODU4, fragmented);
+
+    ASSERT_EQ(report.grooming.size(), 3u);
+    EXPECT_TRUE(report.proven_optimal);
+    EXPECT_FALSE(report.used_fallback);
+    EXPECT_GT(report.nodes_explored, 0u);
+    EXPECT_DOUBLE_EQ(report.cost, 0.0);
+
+    // Validates no overlap / in range
+    EXPECT_NO_THROW(occupied_slot_map(OduLevel::ODU4, report.grooming));
+}
+
+TEST(GroomingPlannerTest, OptimalRepackFallsBackWhenBudgetExhausted) {
+    Odu a(OduLevel::ODU1, 100);
+
+    std::vector<GroomedChild> grooming = {
+        GroomedChild(&a, 1, 3),
+        GroomedChild(&a, 1, 1)
+    };
+
+    RepackBudget budget;
+    budget.max_nodes = 1;
+
+    auto report = repack_grooming_optimal(OduLevel::ODU2, grooming, budget);
+
+    EXPECT_TRUE(report.used_fallback);
+    EXPECT_EQ(report.nodes_explored, 1u);
+    EXPECT_EQ(report.grooming.size(), 2u);
+}
+
+TEST(GroomingPlannerTest, OptimalRepackThrowsWhenNothingFits) {
+    Odu a(OduLevel::ODU1, 100);
+
+    std::vector<GroomedChild> grooming = {
+        GroomedChild(&a, 3, 0),
+        GroomedChild(&a, 2, 3)
+    };
+
+    EXPECT_THROW(
+        repack_grooming_optimal(OduLevel::ODU2, grooming),
+        std::runtime_error
+    );
+}
+
+// ---------------- Non-throwing status API ----------------
+
+TEST(GroomStatusTest, TryPlanGroomingReportsOutcomes) {
+    std::vector<Odu> children(4, Odu(OduLevel::ODU1, 100));
+    std::vector<GroomedChild> out;
+
+    EXPECT_EQ(try_plan_grooming(OduLevel::ODU2, children, out), GroomStatus::OK);
+    ASSERT_EQ(out.size(), 4u);
+    EXPECT_EQ(out[3].slot_offset, 3u);
+
+    children.emplace_back(OduLevel::ODU1, 100);
+    EXPECT_EQ(try_plan_grooming(OduLevel::ODU2, children, out), GroomStatus::INSUFFICIENT_SLOTS);
+    EXPECT_TRUE(out.empty());
+
+    EXPECT_EQ(try_plan_grooming(OduLevel::ODU3, children, out), GroomStatus::INVALID_HIERARCHY);
+
+    children.emplace_back(OduLevel::ODU2, 100);
+    EXPECT_EQ(try_plan_grooming(OduLevel::ODU2, children, out), GroomStatus::MIXED_CHILD_LEVELS);
+}
+
+TEST(GroomStatusTest, TryOccupiedSlotMapReportsOverlapAndRange) {
+    Odu a(OduLevel::ODU1, 100);
+    SlotMap map;
+
+    std::vector<GroomedChild> overlap = {GroomedChild(&a, 2, 0), GroomedChild(&a, 2, 1)};
+    EXPECT_EQ(try_occupied_slot_map(OduLevel::ODU2, overlap, map), GroomStatus::OVERLAPPING_SLOTS);
+
+    std::vector<GroomedChild> overflow = {GroomedChild(&a, 2, 3)};
+    EXPECT_EQ(try_occupied_slot_map(OduLevel::ODU2, overflow, map), GroomStatus::SLOT_OUT_OF_RANGE);
+
+    std::vector<GroomedChild> fine = {GroomedChild(&a, 2, 1)};
+    EXPECT_EQ(try_occupied_slot_map(OduLevel::ODU2, fine, map), GroomStatus::OK);
+    EXPECT_EQ(map.count(), 2u);
+
+    const OduLevel unknown = static_cast<OduLevel>(9);
+    GroomStatus status = GroomStatus::OK;
+    EXPECT_NO_THROW(status = try_occupied_slot_map(unknown, fine, map));
+    EXPECT_EQ(status, GroomStatus::INVALID_HIERARCHY);
+    EXPECT_NO_THROW(status = try_occupied_slot_map(unknown, {}, map));
+    EXPECT_EQ(status, GroomStatus::INVALID_HIERARCHY);
+    EXPECT_THROW(occupied_slot_map(unknown, fine), std::runtime_error);
+}
+
+TEST(GroomStatusTest, TryRepackReportsInsufficientSlots) {
+    Odu a(OduLevel::ODU1, 100);
+    std::vector<GroomedChild> grooming = {GroomedChild(&a, 3, 0), GroomedChild(&a, 2, 3)};
+    std::vector<GroomedChild> out;
+    RepackReport report;
+
+    EXPECT_EQ(try_repack_grooming_size_aware(OduLevel::ODU2, grooming, out), GroomStatus::INSUFFICIENT_SLOTS);
+    EXPECT_EQ(try_repack_grooming_deterministic(OduLevel::ODU2, grooming, out), GroomStatus::INSUFFICIENT_SLOTS);
+    EXPECT_EQ(try_repack_grooming_optimal(OduLevel::ODU2, grooming, report), GroomStatus::INSUFFICIENT_SLOTS);
+    EXPECT_TRUE(out.empty());
+}
+
+TEST(GroomStatusTest, TryGroomMatchesGroomingConstructor) {
+    Odu a(OduLevel::ODU1, 100);
+    Odu b(OduLevel::ODU1, 200);
+    Odu out(OduLevel::ODU2, 0);
+
+    EXPECT_EQ(
+        Odu::try_groom(OduLevel::ODU2, {GroomedChild(&a, 1), GroomedChild(&b, 1)}, out),
+        GroomStatus::OVERLAPPING_SLOTS
+    );
+    EXPECT_FALSE(out.is_aggregated());
+
+    ASSERT_EQ(
+        Odu::try_groom(OduLevel::ODU2, {GroomedChild(&a, 0), GroomedChild(&b, 2)}, out),
+        GroomStatus::OK
+    );
+    EXPECT_EQ(out.payload_size(), 300u);
+    EXPECT_EQ(out.slots(), 2u);
+    EXPECT_EQ(out.leaf_count(), 2u);
+}
+
+TEST(GroomStatusTest, MuxReportsStaticMessages) {
+    Odu a(OduLevel::ODU1, 100);
+    Odu out(OduLevel::ODU2, 0);
+
+    MuxResult r = mux(OduLevel::ODU2, {GroomedChild(&a, 0), GroomedChild(&a, 0)}, out);
+    EXPECT_EQ(r.status, MuxStatus::INSUFFICIENT_CAPACITY);
+    EXPECT_STREQ(r.message, "Overlapping tributary slots");
+
+    EXPECT_STREQ(mux(OduLevel::ODU2, {GroomedChild(&a, 0)}, out).message, "OK");
+}
+
+// ---------------- Minimal-move defragmentation ----------------
+
+TEST(DefragmentationTest, AlreadyMetNeedsNoMoves) {
+    Odu a(OduLevel::ODU1, 100);
+
+    std::vector<GroomedChild> grooming = {
+        GroomedChild(&a, 1, 0)
+    };
+
+    auto plan = plan_defragmentation(
+        OduLevel::ODU2, grooming, DefragTarget::free_run(3)
+    );
+
+    EXPECT_TRUE(plan.target_met);
+    EXPECT_TRUE(plan.moves.empty());
+}
+
+TEST(DefragmentationTest, MovesOnlyTheBlockingChild) {
+    Odu a(OduLevel::ODU1, 100);
+    Odu b(OduLevel::ODU1, 100);
+    Odu c(OduLevel::ODU1, 100);
+
+    // 16 slots: a at 0, b in the middle splits the free space, c at 15
+    std::vector<GroomedChild> grooming = {
+        GroomedChild(&a, 1, 0),
+        GroomedChild(&b, 1, 7),
+        GroomedChild(&c, 1, 15)
+    };
+
+    auto plan = plan_defragmentation(
+        OduLevel::ODU3, grooming, DefragTarget::free_run(10)
+    );
+
+    ASSERT_TRUE(plan.target_met);
+    EXPECT_TRUE(plan.proven_minimal);
+    ASSERT_EQ(plan.moves.size(), 1u);
+    EXPECT_EQ(plan.moves[0].child, &b);
+    EXPECT_EQ(plan.moves[0].from_offset, 7u);
+
+    // Untouched children keep their offsets; the result really has the run
+    EXPECT_EQ(plan.result[0].slot_offset, 0u);
+    EXPECT_EQ(plan.result[2].slot_offset, 15u);
+    EXPECT_NE(
+        occupied_slot_map(OduLevel::ODU3, plan.result).find_first_fit(10),
+        SlotMap::npos
+    );
+}
+
+TEST(DefragmentationTest, EveryMoveIsValidAgainstIntermediateOccupancy) {
+    Odu a(OduLevel::ODU1, 100);
+
+    // ODU2 with 4 slots: [a][ ][a][ ] and a width-2 run is wanted
+    std::vector<GroomedChild> grooming = {
+        GroomedChild(&a, 1, 0),
+        GroomedChild(&a, 1, 2)
+    };
+
+    auto plan = plan_defragmentation(
+        OduLevel::ODU2, grooming, DefragTarget::free_run(2)
+    );
+
+    ASSERT_TRUE(plan.target_met);
+    EXPECT_EQ(plan.moves.size(), 1u);
+
+    SlotMap occupancy = occupied_slot_map(OduLevel::ODU2, grooming);
+    for (const auto& m : plan.moves) {
+        ASSERT_TRUE(occupancy.range_free(m.to_offset, m.slot_width));
+        occupancy.clear_range(m.from_offset, m.slot_width);
+        occupancy.set_range(m.to_offset, m.slot_width);
+    }
+    EXPECT_EQ(occupancy, occupied_slot_map(OduLevel::ODU2, plan.result));
+}
+
+TEST(DefragmentationTest, CostTargetIsReached) {
+    Odu a(OduLevel::ODU1, 100);
+
+    std::vector<GroomedChild> grooming = {
+        GroomedChild(&a, 1, 0),
+        GroomedChild(&a, 1, 2),
+        GroomedChild(&a, 1, 4)
+    };
+
+    auto plan = plan_defragmentation(
+        OduLevel::ODU3, grooming, DefragTarget::cost_below(0.01)
+    );
+
+    ASSERT_TRUE(plan.target_met);
+    EXPECT_EQ(plan.moves.size(), 1u);
+    EXPECT_LT(fragmentation_cost(analyze_fragmentation(plan.result)), 0.01);
+}
+
+TEST(DefragmentationTest, ImpossibleRunIsReported) {
+    Odu a(OduLevel::ODU1, 100);
+
+    std::vector<GroomedChild> grooming = {
+        GroomedChild(&a, 1, 0),
+        GroomedChild(&a, 1, 2)
+    };
+
+    auto plan = plan_defragmentation(
+        OduLevel::ODU2, grooming, DefragTarget::free_run(3)
+    );
+
+    EXPECT_FALSE(plan.target_met);
+    EXPECT_TRUE(plan.moves.empty());
+}
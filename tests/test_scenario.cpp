@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include "otn/scenario.hpp"
+
+#include "temp_file.hpp"
+
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace otn;
+
+namespace {
+
+using otn::test::TempFile;
+
+std::string parse_error(const std::string& text) {
+    std::istringstream in(text);
+    try {
+        parse_scenario(in);
+    } catch (const std::runtime_error& e) {
+        return e.what();
+    }
+    return "";
+}
+
+} // anonymous namespace
+
+TEST(ScenarioTest, ParsesKeysCommentsAndDemandMix) {
+    std::istringstream in(
+        "# baseline\n"
+        "mode = sweep\n"
+        "parent_level = ODU3\n"
+        "parents = 8   # per node\n"
+        "\n"
+        "demand_mix = ODU1:0.5, 2:0.5\n"
+        "policy = first_fit\n"
+        "repack = deterministic\n"
+        "seed = 42\n"
+        "threads = 2\n"
+        "loads = 10, 20.5\n"
+        "topology = mesh.edges\n"
+    );
+    const Scenario s = parse_scenario(in, "/data");
+
+    EXPECT_EQ(s.mode, ScenarioMode::SWEEP);
+    EXPECT_EQ(s.sim.parent_level, OduLevel::ODU3);
+    EXPECT_EQ(s.sim.parent_count, 8u);
+    ASSERT_EQ(s.sim.demand_mix.size(), 2u);
+    EXPECT_EQ(s.sim.demand_mix[1].level, OduLevel::ODU2);
+    EXPECT_DOUBLE_EQ(s.sim.demand_mix[1].weight, 0.5);
+    EXPECT_EQ(s.sim.policy, SimAdmissionPolicy::FIRST_FIT);
+    EXPECT_EQ(s.sim.repack, SimRepackPolicy::DETERMINISTIC);
+    EXPECT_EQ(s.sim.seed, 42u);
+    EXPECT_EQ(s.threads, 2u);
+    ASSERT_EQ(s.loads.size(), 2u);
+    EXPECT_DOUBLE_EQ(s.loads[1], 20.5);
+    EXPECT_EQ(std::filesystem::path(s.topology), std::filesystem::path("/data/mesh.edges"));
+}
+
+TEST(ScenarioTest, ErrorsNameTheLine) {
+    EXPECT_NE(parse_error("seed = 1\nbogus = 2\n").find("Scenario line 2: Unknown scenario key: bogus"),
+              std::string::npos);
+    EXPECT_NE(parse_error("\nparents = -1\n").find("Scenario line 2"), std::string::npos);
+    EXPECT_NE(parse_error("arrival_rate = 1.5x\n").find("Scenario line 1"), std::string::npos);
+    EXPECT_NE(parse_error("demand_mix = ODU9:1\n").find("Unknown ODU level"), std::string::npos);
+    EXPECT_NE(parse_error("mode simulate\n").find("expected key = value"), std::string::npos);
+    EXPECT_NE(parse_error("loads = , \n").find("Load list is empty"), std::string::npos);
+    EXPECT_NE(parse_error("demand_mix = ODU4:1\n").find("cannot be groomed into ODU4"), std::string::npos);
+    EXPECT_NE(parse_error("demand_mix = ODU3:1\nparent_level = ODU3\n").find("Scenario line 2"),
+              std::string::npos);
+}
+
+TEST(ScenarioTest, OverridesReplaceFileValues) {
+    std::istringstream in("policy = first_fit\narrivals = 100\n");
+    Scenario s = parse_scenario(in);
+    apply_scenario_setting(s, "policy", "min_fragmentation");
+
+    EXPECT_EQ(s.sim.policy, SimAdmissionPolicy::MIN_FRAGMENTATION);
+    EXPECT_EQ(s.sim.arrivals, 100u);
+    EXPECT_THROW(apply_scenario_setting(s, "repack", "sometimes"), std::runtime_error);
+}
+
+TEST(ScenarioTest, SimulateReportsThroughputAndBlocking) {
+    Scenario s;
+    s.sim.parent_level = OduLevel::ODU2;
+    s.sim.parent_count = 2;
+    s.sim.arrival_rate = 12.0;
+    s.sim.arrivals = 2000;
+    s.sim.repack = SimRepackPolicy::SIZE_AWARE;
+
+    const ScenarioReport r = run_scenario(s);
+    EXPECT_EQ(r.operations, Simulator(s.sim).run().events);
+    EXPECT_GT(r.blocking, 0.0);
+    EXPECT_LT(r.blocking, 1.0);
+    EXPECT_GT(r.wall_seconds, 0.0);
+
+    std::ostringstream out;
+    print_report(out, s, r);
+    EXPECT_NE(out.str().find("ops/s"), std::string::npos);
+    EXPECT_NE(out.str().find("Repacks:"), std::string::npos);
+}
+
+TEST(ScenarioTest, RouteLoadsTopologyRelativeToScenario) {
+    const TempFile edges("ring.edges");
+    const TempFile conf("ring.conf");
+    edges.write("A B ODU2\nB C ODU2\nC A ODU2\n");
+    conf.write("mode = route\ntopology = " + edges.filename() + "\n"
+               "demand_mix = ODU1:1\ndemands = 30\n");
+
+    const Scenario s = load_scenario(conf.path());
+    const ScenarioReport r = run_scenario(s);
+
+    // Three ODU2 links hold 12 ODU1 hops; every demand takes at least one
+    EXPECT_EQ(r.operations, 30u);
+    EXPECT_GE(r.blocking, 18.0 / 30.0);
+    EXPECT_DOUBLE_EQ(r.mean_utilization, 1.0);
+}
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+
+#include "otn/monte_carlo.hpp"
+#include "otn/simulation.hpp"
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace otn;
+
+// ---------------- EventQueue ----------------
+
+TEST(EventQueueTest, PopsByTimeThenInsertionOrder) {
+    EventQueue q;
+    q.push(2.0, EventType::ARRIVAL, 1);
+    q.push(1.0, EventType::DEPARTURE, 2);
+    q.push(2.0, EventType::DEPARTURE, 3);
+    q.push(0.5, EventType::ARRIVAL, 4);
+
+    EXPECT_EQ(q.pop().demand, 4u);
+    EXPECT_EQ(q.pop().demand, 2u);
+    EXPECT_EQ(q.pop().demand, 1u);
+    EXPECT_EQ(q.pop().demand, 3u);
+    EXPECT_TRUE(q.empty());
+}
+
+// ---------------- Simulator ----------------
+
+static double erlang_b(std::size_t servers, double load) {
+    double b = 1.0;
+    for (std::size_t k = 1; k <= servers; ++k) {
+        b = load * b / (static_cast<double>(k) + load * b);
+    }
+    return b;
+}
+
+TEST(SimulatorTest, SingleSlotDemandsMatchErlangB) {
+    // ODU1 demands into one ODU2: a 4-server loss system
+    SimulationConfig config;
+    config.parent_level = OduLevel::ODU2;
+    config.arrival_rate = 2.0;
+    config.mean_holding_time = 1.0;
+    config.arrivals = 200000;
+    config.warmup_arrivals = 1000;
+    config.seed = 7;
+
+    SimulationStats stats = Simulator(config).run();
+
+    EXPECT_EQ(stats.arrivals, 200000u);
+    EXPECT_NEAR(stats.blocking_probability, erlang_b(4, 2.0), 0.01);
+    EXPECT_GT(stats.mean_utilization, 0.0);
+    EXPECT_LT(stats.mean_utilization, 1.0);
+}
+
+TEST(SimulatorTest, SameSeedIsReproducible) {
+    SimulationConfig config;
+    config.parent_count = 3;
+    config.demand_mix = {{OduLevel::ODU1, 0.7}, {OduLevel::ODU2, 0.3}};
+    config.arrival_rate = 40.0;
+    config.arrivals = 20000;
+    config.seed = 99;
+
+    SimulationStats a = Simulator(config).run();
+    SimulationStats b = Simulator(config).run();
+
+    EXPECT_EQ(a.blocked, b.blocked);
+    EXPECT_EQ(a.events, b.events);
+    EXPECT_EQ(a.mean_fragmentation_cost, b.mean_fragmentation_cost);
+    EXPECT_EQ(a.arrivals_per_level, b.arrivals_per_level);
+}
+
+TEST(SimulatorTest, LightLoadNeverBlocksAndOverloadDoes) {
+    SimulationConfig light;
+    light.arrival_rate = 1.0;
+    light.arrivals = 5000;
+    EXPECT_EQ(Simulator(light).run().blocked, 0u);
+
+    SimulationConfig heavy = light;
+    heavy.policy = SimAdmissionPolicy::FIRST_FIT;
+    heavy.demand_mix = {{OduLevel::ODU3, 1.0}};
+    heavy.arrival_rate = 50.0;
+    SimulationStats stats = Simulator(heavy).run();
+
+    EXPECT_GT(stats.blocking_probability, 0.5);
+    EXPECT_EQ(stats.blocked_per_level[3], stats.blocked);
+}
+
+TEST(SimulatorTest, RejectsDemandsNotBelowParent) {
+    SimulationConfig config;
+    config.demand_mix = {{OduLevel::ODU1, 0.5}, {OduLevel::ODU4, 0.5}};
+    EXPECT_THROW(Simulator{config}, std::runtime_error);
+
+    config.parent_level = OduLevel::ODU2;
+    config.demand_mix = {{OduLevel::ODU2, 1.0}};
+    EXPECT_THROW(Simulator{config}, std::runtime_error);
+
+    config.demand_mix = {{OduLevel::ODU1, 1.0}};
+    EXPECT_NO_THROW(Simulator{config});
+}
+
+TEST(SimulatorTest, RepackOnBlockAdmitsFragmentedArrivals) {
+    // Mixed ODU1/ODU2 into ODU3s: first fit leaves 4-slot holes scattered
+    SimulationConfig config;
+    config.parent_level = OduLevel::ODU3;
+    config.parent_count = 2;
+    config.demand_mix = {{OduLevel::ODU1, 0.7}, {OduLevel::ODU2, 0.3}};
+    config.policy = SimAdmissionPolicy::FIRST_FIT;
+    config.arrival_rate = 12.0;
+    config.arrivals = 20000;
+    config.seed = 5;
+
+    const SimulationStats plain = Simulator(config).run();
+    EXPECT_EQ(plain.repacks, 0u);
+
+    // A small node budget keeps the optimal search quick; any packing it returns is valid
+    config.repack_budget.max_nodes = 500;
+
+    for (SimRepackPolicy policy :
+         {SimRepackPolicy::SIZE_AWARE, SimRepackPolicy::DETERMINISTIC, SimRepackPolicy::OPTIMAL}) {
+        config.repack = policy;
+        const SimulationStats repacked = Simulator(config).run();
+
+        EXPECT_GT(repacked.repacks, 0u);
+        EXPECT_GT(repacked.repack_admissions, 0u);
+        EXPECT_LT(repacked.blocked_per_level[2], plain.blocked_per_level[2]);
+        EXPECT_LE(repacked.repack_admissions, repacked.repacks);
+    }
+}
+
+TEST(SimulatorTest, FitPoliciesShapeOdu2Blocking) {
+    SimulationConfig config;
+    config.parent_level = OduLevel::ODU3;
+    config.parent_count = 2;
+    config.demand_mix = {{OduLevel::ODU1, 0.7}, {OduLevel::ODU2, 0.3}};
+    config.arrival_rate = 12.0;
+    config.arrivals = 20000;
+    config.seed = 5;
+
+    std::array<uint64_t, kCostPolicyKindCount> odu2_blocked{};
+    for (const std::string& name : cost_policy_names()) {
+        config.policy = parse_cost_policy(name);
+        const SimulationStats stats = Simulator(config).run();
+        EXPECT_EQ(stats.arrivals, config.arrivals) << name;
+        odu2_blocked[static_cast<std::size_t>(config.policy)] = stats.blocked_per_level[2];
+    }
+
+    // Keeping small demands out of large holes leaves room for ODU2s
+    const auto blocked = [&](CostPolicyKind k) { return odu2_blocked[static_cast<std::size_t>(k)]; };
+    EXPECT_LT(blocked(CostPolicyKind::BEST_FIT), blocked(CostPolicyKind::FIRST_FIT));
+}
+
+// ---------------- Monte Carlo ----------------
+
+TEST(MonteCarloTest, EstimateMatchesHandComputedValues) {
+    Estimate e = estimate({1.0, 2.0, 3.0, 4.0});
+
+    EXPECT_DOUBLE_EQ(e.mean, 2.5);
+    EXPECT_NEAR(e.stddev, 1.2909944, 1e-6);
+    EXPECT_NEAR(e.ci_half_width, 3.182 * e.stddev / 2.0, 1e-12);
+    EXPECT_EQ(estimate({}).samples, 0u);
+}
+
+TEST(MonteCarloTest, SeedsAreDistinctPerReplicationAndLoadPoint) {
+    EXPECT_NE(replication_seed(1, 0, 0), replication_seed(1, 0, 1));
+    EXPECT_NE(replication_seed(1, 0, 1), replication_seed(1, 1, 0));
+    EXPECT_NE(replication_seed(1, 0, 0), replication_seed(2, 0, 0));
+    EXPECT_EQ(replication_seed(7, 3, 5), replication_seed(7, 3, 5));
+}
+
+TEST(MonteCarloTest, BitIdenticalForAnyThreadCount) {
+    MonteCarloConfig config;
+    config.base.parent_level = OduLevel::ODU2;
+    config.base.demand_mix = {{OduLevel::ODU1, 1.0}};
+    config.base.arrivals = 2000;
+    config.loads = {1.0, 3.0, 6.0};
+    config.replications = 8;
+    config.base_seed = 42;
+
+    config.threads = 1;
+    MonteCarloResult serial = run_monte_carlo(config);
+    config.threads = 4;
+    MonteCarloResult parallel = run_monte_carlo(config);
+
+    ASSERT_EQ(serial.points.size(), 3u);
+    EXPECT_EQ(serial.total_events, parallel.total_events);
+    for (std::size_t i = 0; i < serial.points.size(); ++i) {
+        const auto& a = serial.points[i];
+        const auto& b = parallel.points[i];
+        EXPECT_EQ(a.blocking.mean, b.blocking.mean);
+        EXPECT_EQ(a.blocking.ci_half_width, b.blocking.ci_half_width);
+        EXPECT_EQ(a.fragmentation_cost.mean, b.fragmentation_cost.mean);
+        EXPECT_EQ(a.blocked_per_level, b.blocked_per_level);
+    }
+}
+
+TEST(MonteCarloTest, BlockingGrowsWithLoadAndBracketsErlangB) {
+    MonteCarloConfig config;
+    config.base.parent_level = OduLevel::ODU2;
+    config.base.demand_mix = {{OduLevel::ODU1, 1.0}};
+    config.base.arrivals = 5000;
+    config.base.warmup_arrivals = 500;
+    config.loads = {1.0, 4.0};
+    config.replications = 12;
+
+    MonteCarloResult result = run_monte_carlo(config);
+
+    const auto& low = result.points[0];
+    const auto& high = result.points[1];
+    EXPECT_LT(low.blocking.mean, high.blocking.mean);
+    EXPECT_EQ(high.blocking_per_level[1].samples, 12u);
+    EXPECT_EQ(high.blocking_per_level[2].samples, 0u);
+
+    // Loose bracket: twice the 95% half-width around Erlang B
+    EXPECT_NEAR(high.blocking.mean, erlang_b(4, 4.0), 2.0 * high.blocking.ci_half_width + 0.01);
+}
+
+TEST(MonteCarloTest, RejectsEmptySweep) {
+    MonteCarloConfig config;
+    EXPECT_THROW(run_monte_carlo(config), std::runtime_error);
+}
@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include "otn/level_slot_map.hpp"
+#include "otn/slot_map.hpp"
+#include "otn/otn_types.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace otn;
+
+// ---------------- SlotMap ----------------
+
+TEST(SlotMapTest, StartsEmpty) {
+    SlotMap map(tributary_slots(OduLevel::ODU4));
+
+    EXPECT_EQ(map.capacity(), 80u);
+    EXPECT_EQ(map.count(), 0u);
+    EXPECT_EQ(map.free_count(), 80u);
+    EXPECT_TRUE(map.none());
+}
+
+TEST(SlotMapTest, SetRangeSpansWordBoundary) {
+    SlotMap map(80);
+    map.set_range(60, 10);
+
+    EXPECT_EQ(map.count(), 10u);
+    EXPECT_FALSE(map.test(59));
+    EXPECT_TRUE(map.test(60));
+    EXPECT_TRUE(map.test(63));
+    EXPECT_TRUE(map.test(64));
+    EXPECT_TRUE(map.test(69));
+    EXPECT_FALSE(map.test(70));
+
+    map.clear_range(62, 4);
+    EXPECT_EQ(map.count(), 6u);
+    EXPECT_FALSE(map.test(63));
+    EXPECT_FALSE(map.test(64));
+}
+
+TEST(SlotMapTest, RangeFreeRespectsCapacity) {
+    SlotMap map(4);
+
+    EXPECT_TRUE(map.range_free(0, 4));
+    EXPECT_FALSE(map.range_free(1, 4));
+    EXPECT_FALSE(map.range_free(5, 0));
+
+    map.set_range(2, 1);
+    EXPECT_FALSE(map.range_free(0, 4));
+    EXPECT_TRUE(map.range_free(0, 2));
+    EXPECT_TRUE(map.range_free(3, 1));
+}
+
+TEST(SlotMapTest, FitMaskMatchesBruteForce) {
+    SlotMap map(80);
+    map.set_range(3, 2);
+    map.set_range(20, 16);
+    map.set_range(63, 2);
+    map.set_range(79, 1);
+
+    for (std::size_t width : {1u, 2u, 4u, 16u, 40u}) {
+        const auto offsets = map.fit_mask(width).to_offsets();
+
+        std::vector<std::size_t> expected;
+        for (std::size_t start = 0; start + width <= 80; ++start) {
+            if (map.range_free(start, width)) expected.push_back(start);
+        }
+
+        EXPECT_EQ(offsets, expected) << "width " << width;
+    }
+}
+
+TEST(SlotMapTest, FitMaskEveryWidthMatchesBruteForce) {
+    std::mt19937 rng(3);
+
+    for (int trial = 0; trial < 20; ++trial) {
+        SlotMap map(80);
+        for (std::size_t i = 0; i < 80; ++i) {
+            if (rng() % 8 == 0) map.set_range(i, 1);
+        }
+
+        for (std::size_t width = 1; width <= 80; ++width) {
+            SlotMap expected(80);
+            for (std::size_t start = 0; start + width <= 80; ++start) {
+                if (map.range_free(start, width)) expected.set_range(start, 1);
+            }
+            ASSERT_EQ(map.fit_mask(width), expected) << "width " << width;
+            ASSERT_EQ(
+                LevelSlotMap<OduLevel::ODU4>::from_slot_map(map).fit_mask(width).to_slot_map(),
+                expected
+            ) << "width " << width;
+        }
+    }
+}
+
+TEST(SlotMapTest, WriteOffsetsIsCompactToOffsets) {
+    SlotMap map(80);
+    map.set_range(0, 1);
+    map.set_range(62, 4);
+    map.set_range(79, 1);
+
+    std::uint8_t buffer[SlotMap::kMaxSlots];
+    const std::size_t n = map.write_offsets(buffer);
+
+    const auto offsets = map.to_offsets();
+    ASSERT_EQ(n, offsets.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(buffer[i], offsets[i]);
+    }
+    EXPECT_EQ(SlotMap(16).write_offsets(buffer), 0u);
+}
+
+TEST(SlotMapTest, FindFirstFitSkipsOccupiedRuns) {
+    SlotMap map(16);
+    map.set_range(0, 3);
+    map.set_range(5, 2);
+
+    EXPECT_EQ(map.find_first_fit(1), 3u);
+    EXPECT_EQ(map.find_first_fit(2), 3u);
+    EXPECT_EQ(map.find_first_fit(3), 7u);
+    EXPECT_EQ(map.find_first_fit(2, 4), 7u);
+    EXPECT_EQ(map.find_first_fit(10), SlotMap::npos);
+}
+
+TEST(SlotMapTest, FindPrevSetCrossesWords) {
+    SlotMap map(80);
+    map.set_range(3, 1);
+    map.set_range(70, 2);
+
+    EXPECT_EQ(map.find_prev_set(80), 71u);
+    EXPECT_EQ(map.find_prev_set(71), 70u);
+    EXPECT_EQ(map.find_prev_set(70), 3u);
+    EXPECT_EQ(map.find_prev_set(64), 3u);
+    EXPECT_EQ(map.find_prev_set(3), SlotMap::npos);
+    EXPECT_EQ(map.find_prev_set(0), SlotMap::npos);
+}
+
+TEST(SlotMapTest, OverlapIsWordAnd) {
+    SlotMap a(80);
+    SlotMap b(80);
+    a.set_range(0, 10);
+    b.set_range(70, 10);
+
+    EXPECT_FALSE(a.overlaps(b));
+
+    b.set_range(9, 1);
+    EXPECT_TRUE(a.overlaps(b));
+}
+
+TEST(SlotMapTest, RejectsOversizedCapacity) {
+    EXPECT_THROW(SlotMap(SlotMap::kMaxSlots + 1), std::runtime_error);
+}
+
+// ---------------- FixedSlotMap ----------------
+
+static_assert(tributary_slots(OduLevel::ODU4) == 80, "level table is constexpr");
+static_assert(nominal_capacity(OduLevel::ODU2) == 10000, "level table is constexpr");
+
+static_assert(sizeof(LevelSlotMap<OduLevel::ODU2>) == 1, "ODU2 map is one byte");
+static_assert(sizeof(LevelSlotMap<OduLevel::ODU3>) == 2, "ODU3 map is one 16-bit word");
+static_assert(LevelSlotMap<OduLevel::ODU4>::kWords == 2, "ODU4 map is two 64-bit words");
+
+static_assert(
+    [] {
+        LevelSlotMap<OduLevel::ODU2> m;
+        m.set_range(1, 2);
+        return m.find_first_fit(1) == 0 && m.find_first_fit(2) == SlotMap::npos;
+    }(),
+    "kernels fold at compile time"
+);
+
+template <std::size_t N>
+static void expect_matches_slot_map(std::mt19937& rng) {
+    for (int trial = 0; trial < 200; ++trial) {
+        FixedSlotMap<N> fixed;
+        SlotMap dynamic(N);
+
+        for (std::size_t i = 0; i < N; ++i) {
+            if (rng() % 3 == 0) {
+                fixed.set_range(i, 1);
+                dynamic.set_range(i, 1);
+            }
+        }
+
+        ASSERT_EQ(fixed.to_slot_map(), dynamic);
+        ASSERT_EQ(FixedSlotMap<N>::from_slot_map(dynamic), fixed);
+        ASSERT_EQ(fixed.count(), dynamic.count());
+
+        for (std::size_t width : {1, 2, 4, 7, 16, 33}) {
+            if (width > N) continue;
+            ASSERT_EQ(fixed.fit_mask(width).to_slot_map(), dynamic.fit_mask(width));
+            ASSERT_EQ(fixed.find_first_fit(width, 3), dynamic.find_first_fit(width, 3));
+        }
+    }
+}
+
+TEST(FixedSlotMapTest, MatchesSlotMapForEveryLevel) {
+    std::mt19937 rng(7);
+    expect_matches_slot_map<1>(rng);
+    expect_matches_slot_map<4>(rng);
+    expect_matches_slot_map<16>(rng);
+    expect_matches_slot_map<80>(rng);
+}
+
+TEST(FixedSlotMapTest, RangeOpsCrossWordBoundary) {
+    LevelSlotMap<OduLevel::ODU4> map;
+    map.set_range(60, 8);
+
+    EXPECT_FALSE(map.range_free(63, 2));
+    EXPECT_TRUE(map.range_free(68, 12));
+    EXPECT_FALSE(map.range_free(70, 11));
+    EXPECT_EQ(map.count(), 8u);
+
+    map.clear_range(62, 4);
+    EXPECT_EQ(map.count(), 4u);
+    EXPECT_EQ(map.find_next_set(61), 61u);
+    EXPECT_EQ(map.find_next_set(62), 66u);
+}
+
+TEST(FixedSlotMapTest, DispatchSelectsCompileTimeLevel) {
+    for (OduLevel level : {OduLevel::ODU1, OduLevel::ODU2, OduLevel::ODU3, OduLevel::ODU4}) {
+        const std::size_t slots = dispatch_level(level, [](auto l) {
+            return LevelSlotMap<l>::capacity();
+        });
+        EXPECT_EQ(slots, tributary_slots(level));
+    }
+    EXPECT_THROW(
+        dispatch_level(static_cast<OduLevel>(0), [](auto) { return 0; }),
+        std::runtime_error
+    );
+}
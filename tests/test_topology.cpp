@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include "otn/topology.hpp"
+
+#include <sstream>
+
+using namespace otn;
+
+namespace {
+
+/*
+ *  A --- B --- D      every link weight 1 except A-C-D (2 each)
+ *   \         /
+ *    --- C ---
+ */
+Topology diamond() {
+    std::istringstream in(
+        "# src dst level weight\n"
+        "A B ODU2\n"
+        "B D OTU2 1\n"
+        "\n"
+        "A C 2 2.0\n"
+        "C D ODU2 2.0\n"
+    );
+    return Topology::from_edge_list(in);
+}
+
+} // anonymous namespace
+
+// ---------------- Topology ----------------
+
+TEST(TopologyTest, LoadsEdgeList) {
+    Topology topo = diamond();
+
+    EXPECT_EQ(topo.node_count(), 4u);
+    EXPECT_EQ(topo.link_count(), 4u);
+
+    const Link& ac = topo.link(2);
+    EXPECT_EQ(topo.node_name(ac.a), "A");
+    EXPECT_EQ(topo.node_name(ac.b), "C");
+    EXPECT_EQ(ac.level, OduLevel::ODU2);
+    EXPECT_DOUBLE_EQ(ac.weight, 2.0);
+    EXPECT_EQ(ac.occupancy.capacity(), tributary_slots(OduLevel::ODU2));
+}
+
+TEST(TopologyTest, RejectsMalformedLines) {
+    std::istringstream missing_level("A B\n");
+    EXPECT_THROW(Topology::from_edge_list(missing_level), std::runtime_error);
+
+    std::istringstream bad_level("A B ODU7\n");
+    EXPECT_THROW(Topology::from_edge_list(bad_level), std::runtime_error);
+
+    std::istringstream self_loop("A A ODU2\n");
+    EXPECT_THROW(Topology::from_edge_list(self_loop), std::runtime_error);
+}
+
+TEST(TopologyTest, ReserveBumpsVersion) {
+    Topology topo = diamond();
+
+    EXPECT_TRUE(topo.reserve(0, 0, 2));
+    EXPECT_EQ(topo.link(0).version, 1u);
+    EXPECT_FALSE(topo.reserve(0, 1, 1));
+    EXPECT_FALSE(topo.reserve(0, 3, 2));
+
+    topo.release(0, 0, 2);
+    EXPECT_EQ(topo.link(0).version, 2u);
+    EXPECT_THROW(topo.release(0, 0, 1), std::runtime_error);
+}
+
+// ---------------- Router ----------------
+
+TEST(RouterTest, KShortestPathsAreOrderedAndLoopless) {
+    Topology topo = diamond();
+    Router router(topo, 3);
+
+    const auto& paths = router.paths(topo.node_id("A"), topo.node_id("D"));
+
+    ASSERT_EQ(paths.size(), 2u);
+    EXPECT_DOUBLE_EQ(paths[0].cost, 2.0);
+    EXPECT_DOUBLE_EQ(paths[1].cost, 4.0);
+    EXPECT_EQ(topo.node_name(paths[0].nodes[1]), "B");
+    EXPECT_EQ(topo.node_name(paths[1].nodes[1]), "C");
+}
+
+TEST(RouterTest, RoutesAroundFullLinks) {
+    Topology topo = diamond();
+    Router router(topo, 2);
+    const NodeId a = topo.node_id("A");
+    const NodeId d = topo.node_id("D");
+
+    // Four ODU1s fill the short path, the next one takes the long one
+    for (int i = 0; i < 4; ++i) {
+        auto route = router.route_and_reserve(a, d, OduLevel::ODU1);
+        ASSERT_TRUE(route);
+        EXPECT_DOUBLE_EQ(route->cost, 2.0);
+        EXPECT_EQ(route->offsets, (std::vector<uint16_t>{uint16_t(i), uint16_t(i)}));
+    }
+
+    auto detour = router.route_and_reserve(a, d, OduLevel::ODU1);
+    ASSERT_TRUE(detour);
+    EXPECT_DOUBLE_EQ(detour->cost, 4.0);
+
+    // An ODU2 needs all four slots of every hop
+    EXPECT_FALSE(router.find_route(a, d, OduLevel::ODU2));
+
+    router.release(*detour);
+    auto full = router.find_route(a, d, OduLevel::ODU2);
+    ASSERT_TRUE(full);
+    EXPECT_DOUBLE_EQ(full->cost, 4.0);
+}
+
+TEST(RouterTest, HopsPickOffsetsIndependently) {
+    Topology topo = diamond();
+    Router router(topo, 1);
+
+    ASSERT_TRUE(topo.reserve(0, 0, 1));   // A-B slot 0 taken
+    auto route = router.find_route(topo.node_id("A"), topo.node_id("D"), OduLevel::ODU1);
+
+    ASSERT_TRUE(route);
+    EXPECT_EQ(route->offsets, (std::vector<uint16_t>{1, 0}));
+}
+
+TEST(RouterTest, DemandLargerThanLinkIsBlocked) {
+    Topology topo = diamond();
+    Router router(topo);
+
+    EXPECT_FALSE(router.find_route(topo.node_id("A"), topo.node_id("D"), OduLevel::ODU3));
+}
+
+TEST(RouterTest, GrowingTopologyRefreshesCachedPaths) {
+    Topology topo = diamond();
+    Router router(topo, 1);
+    const NodeId a = topo.node_id("A");
+    const NodeId d = topo.node_id("D");
+
+    EXPECT_DOUBLE_EQ(router.paths(a, d)[0].cost, 2.0);
+
+    // A direct link and a brand-new node both show up on the next query
+    topo.add_link(a, d, OduLevel::ODU2, 0.5);
+    EXPECT_DOUBLE_EQ(router.paths(a, d)[0].cost, 0.5);
+
+    const NodeId e = topo.add_node("E");
+    topo.add_link(d, e, OduLevel::ODU2);
+    auto route = router.find_route(a, e, OduLevel::ODU1);
+    ASSERT_TRUE(route);
+    EXPECT_DOUBLE_EQ(route->cost, 1.5);
+}
@@ -0,0 +1,312 @@
+#include <gtest/gtest.h>
+
+#include "otn/bounded_queue.hpp"
+#include "otn/trace.hpp"
+
+#include "temp_file.hpp"
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace otn;
+
+namespace {
+
+using otn::test::TempFile;
+
+std::vector<TraceRecord> read_all(TraceReader& reader) {
+    std::vector<TraceRecord> out;
+    TraceRecord r;
+    while (reader.next(r)) out.push_back(r);
+    return out;
+}
+
+TraceRecord add(double t, uint64_t id, OduLevel level, uint32_t preferred = kNoPreferredParent) {
+    TraceRecord r;
+    r.timestamp = t;
+    r.demand_id = id;
+    r.level = level;
+    r.payload_bytes = 100;
+    r.preferred_parent = preferred;
+    return r;
+}
+
+TraceRecord remove(double t, uint64_t id) {
+    TraceRecord r;
+    r.timestamp = t;
+    r.demand_id = id;
+    r.op = TraceOp::REMOVE;
+    return r;
+}
+
+} // anonymous namespace
+
+// ---------------- BoundedQueue ----------------
+
+TEST(BoundedQueueTest, CloseDrainsThenFails) {
+    BoundedQueue<int> q(2);
+    EXPECT_TRUE(q.push(1));
+    EXPECT_TRUE(q.try_push(2));
+    EXPECT_FALSE(q.try_push(3));   // full
+
+    q.close();
+    EXPECT_FALSE(q.push(4));
+
+    int v = 0;
+    EXPECT_TRUE(q.pop(v));
+    EXPECT_EQ(v, 1);
+    EXPECT_TRUE(q.pop(v));
+    EXPECT_EQ(v, 2);
+    EXPECT_FALSE(q.pop(v));
+}
+
+TEST(BoundedQueueTest, BlockedProducerResumesWhenConsumed) {
+    BoundedQueue<int> q(1);
+    std::thread producer([&] {
+        for (int i = 0; i < 100; ++i) q.push(i);
+        q.close();
+    });
+
+    int v = 0, expected = 0;
+    while (q.pop(v)) EXPECT_EQ(v, expected++);
+    producer.join();
+    EXPECT_EQ(expected, 100);
+}
+
+// ---------------- CSV ----------------
+
+TEST(TraceReaderTest, ParsesCsvWithHeaderCommentsAndCrlf) {
+    TempFile file("otn_trace_basic.csv");
+    file.write(
+        "timestamp,op,demand_id,level,payload_bytes,preferred_parent\r\n"
+        "# warm start\r\n"
+        "0.5,add,7,ODU2,1000,3\r\n"
+        "\r\n"
+        "1.25, ADD ,8,1,10\n"
+        "2,remove,7,,\n"
+        "3,remove,8"
+    );
+
+    TraceReader reader(file.path());
+    EXPECT_EQ(reader.format(), TraceFormat::CSV);
+    const auto records = read_all(reader);
+
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_DOUBLE_EQ(records[0].timestamp, 0.5);
+    EXPECT_EQ(records[0].op, TraceOp::ADD);
+    EXPECT_EQ(records[0].demand_id, 7u);
+    EXPECT_EQ(records[0].level, OduLevel::ODU2);
+    EXPECT_EQ(records[0].payload_bytes, 1000u);
+    EXPECT_EQ(records[0].preferred_parent, 3u);
+
+    EXPECT_EQ(records[1].level, OduLevel::ODU1);
+    EXPECT_EQ(records[1].preferred_parent, kNoPreferredParent);
+
+    EXPECT_EQ(records[2].op, TraceOp::REMOVE);
+    EXPECT_EQ(records[3].demand_id, 8u);
+    EXPECT_EQ(reader.records_delivered(), 4u);
+}
+
+TEST(TraceReaderTest, DeliversEveryRecordAcrossSmallChunks) {
+    TempFile file("otn_trace_chunks.csv");
+    std::string text;
+    for (int i = 0; i < 1000; ++i) {
+        text += std::to_string(i) + ",add," + std::to_string(i) + ",ODU1,1\n";
+    }
+    file.write(text);
+
+    TraceReaderOptions options;
+    options.chunk_records = 7;
+    options.queue_chunks = 2;
+    TraceReader reader(file.path(), options);
+
+    const auto records = read_all(reader);
+    ASSERT_EQ(records.size(), 1000u);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(records[i].demand_id, i);
+    }
+
+    TraceRecord r;
+    EXPECT_FALSE(reader.next(r));   // stays at end
+}
+
+TEST(TraceReaderTest, ReportsErrorAfterEarlierRecords) {
+    TempFile file("otn_trace_error.csv");
+    file.write(
+        "1,add,1,ODU1,1\n"
+        "2,add,2,ODU1,1\n"
+        "3,resize,3,ODU1,1\n"
+        "4,add,4,ODU1,1\n"
+    );
+
+    TraceReader reader(file.path());
+    TraceRecord r;
+    ASSERT_TRUE(reader.next(r));
+    ASSERT_TRUE(reader.next(r));
+    EXPECT_EQ(r.demand_id, 2u);
+
+    try {
+        reader.next(r);
+        FAIL() << "expected a parse error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("Trace line 3"), std::string::npos);
+    }
+    EXPECT_FALSE(reader.next(r));
+}
+
+TEST(TraceReaderTest, RejectsInvalidRecords) {
+    const std::vector<std::string> bad = {
+        "1,add,1,ODU5,1\n",                    // unknown level
+        "1,add,1,ODU1,999999999\n",            // over nominal capacity
+        "1,add,1\n",                           // add without level/payload
+        "2,add,1,ODU1,1\n1,add,2,ODU1,1\n",    // time goes backwards
+        "1,add,x,ODU1,1\n",
+        "1,add,1,ODU1,1,0,extra\n",
+    };
+
+    TempFile file("otn_trace_invalid.csv");
+    for (const auto& text : bad) {
+        file.write(text);
+        TraceReader reader(file.path());
+        EXPECT_THROW(read_all(reader), std::runtime_error) << text;
+    }
+}
+
+TEST(TraceReaderTest, EarlyDestructionStopsParser) {
+    TempFile file("otn_trace_early.csv");
+    std::string text;
+    for (int i = 0; i < 100000; ++i) text += "0,add,1,ODU1,1\n";
+    file.write(text);
+
+    TraceReaderOptions options;
+    options.chunk_records = 16;
+    options.queue_chunks = 1;
+
+    TraceReader reader(file.path(), options);
+    TraceRecord r;
+    EXPECT_TRUE(reader.next(r));
+    // Destructor must not hang on the blocked parser
+}
+
+// ---------------- Binary ----------------
+
+TEST(TraceReaderTest, BinaryRoundTripIsDetected) {
+    TempFile file("otn_trace.bin");
+    {
+        BinaryTraceWriter writer(file.path());
+        writer.write(add(0.0, 1, OduLevel::ODU2, 1));
+        writer.write(add(1.0, 2, OduLevel::ODU1));
+        writer.write(remove(2.0, 1));
+        writer.close();
+        EXPECT_EQ(writer.records_written(), 3u);
+    }
+
+    TraceReader reader(file.path());
+    EXPECT_EQ(reader.format(), TraceFormat::BINARY);
+
+    std::vector<TraceRecord> chunk;
+    ASSERT_TRUE(reader.next_chunk(chunk));
+    ASSERT_EQ(chunk.size(), 3u);
+    EXPECT_EQ(chunk[0].level, OduLevel::ODU2);
+    EXPECT_EQ(chunk[0].preferred_parent, 1u);
+    EXPECT_EQ(chunk[2].op, TraceOp::REMOVE);
+    EXPECT_FALSE(reader.next_chunk(chunk));
+}
+
+TEST(TraceReaderTest, RejectsTruncatedBinary) {
+    TempFile file("otn_trace_truncated.bin");
+    {
+        BinaryTraceWriter writer(file.path());
+        writer.write(add(0.0, 1, OduLevel::ODU1));
+    }
+    std::filesystem::resize_file(file.path(), std::filesystem::file_size(file.path()) - 4);
+
+    EXPECT_THROW(TraceReader(file.path()), std::runtime_error);
+
+    TraceReaderOptions options;
+    options.format = TraceFormat::BINARY;
+    TempFile csv("otn_trace_not_binary.csv");
+    csv.write("0,add,1,ODU1,1\n");
+    EXPECT_THROW(TraceReader(csv.path(), options), std::runtime_error);
+}
+
+// ---------------- Replay ----------------
+
+TEST(TraceReplayerTest, AdmitsBlocksAndReleases) {
+    ReplayConfig config;
+    config.parent_level = OduLevel::ODU2;
+    config.parent_count = 1;
+    TraceReplayer replayer(config);
+
+    for (uint64_t id = 0; id < 4; ++id) replayer.apply(add(0.0, id, OduLevel::ODU1));
+    replayer.apply(add(1.0, 4, OduLevel::ODU1));     // parent full
+    replayer.apply(remove(2.0, 4));                   // was blocked
+    replayer.apply(remove(2.0, 1));
+    replayer.apply(add(3.0, 5, OduLevel::ODU1));     // takes the freed slot
+    replayer.apply(add(3.0, 5, OduLevel::ODU1));     // duplicate id
+
+    const ReplayStats s = replayer.stats();
+    EXPECT_EQ(s.records, 9u);
+    EXPECT_EQ(s.adds, 6u);
+    EXPECT_EQ(s.admitted, 5u);
+    EXPECT_EQ(s.blocked, 1u);
+    EXPECT_EQ(s.blocked_per_level[1], 1u);
+    EXPECT_EQ(s.unknown_removes, 1u);
+    EXPECT_EQ(s.duplicate_adds, 1u);
+    EXPECT_DOUBLE_EQ(s.blocking_probability, 1.0 / 6.0);
+    EXPECT_DOUBLE_EQ(s.final_utilization, 1.0);
+    EXPECT_DOUBLE_EQ(s.trace_duration, 3.0);
+    // Full for [0, 2), three quarters for [2, 3)
+    EXPECT_DOUBLE_EQ(s.mean_utilization, (2.0 * 1.0 + 1.0 * 0.75) / 3.0);
+    EXPECT_EQ(replayer.active_demands(), 4u);
+}
+
+TEST(TraceReplayerTest, PrefersRequestedParent) {
+    ReplayConfig config;
+    config.parent_level = OduLevel::ODU2;
+    config.parent_count = 2;
+    config.policy = SimAdmissionPolicy::FIRST_FIT;
+    TraceReplayer replayer(config);
+
+    replayer.apply(add(0.0, 1, OduLevel::ODU1, 1));
+    replayer.apply(add(0.0, 2, OduLevel::ODU1));
+    replayer.apply(add(0.0, 3, OduLevel::ODU1, 7));   // no such parent: ignored
+
+    EXPECT_EQ(replayer.parent(1).occupancy().count(), 1u);
+    EXPECT_EQ(replayer.parent(0).occupancy().count(), 2u);
+    EXPECT_EQ(replayer.stats().preferred_parent_hits, 1u);
+}
+
+TEST(TraceReplayerTest, RejectsDemandsNotBelowParent) {
+    ReplayConfig config;
+    config.parent_level = OduLevel::ODU2;
+    TraceReplayer replayer(config);
+
+    EXPECT_THROW(replayer.apply(add(0.0, 1, OduLevel::ODU2)), std::runtime_error);
+    EXPECT_THROW(replayer.apply(add(0.0, 2, OduLevel::ODU3)), std::runtime_error);
+    EXPECT_EQ(replayer.stats().adds, 0u);
+    EXPECT_EQ(replayer.active_demands(), 0u);
+}
+
+TEST(TraceReplayerTest, ReplayTraceDrainsReader) {
+    TempFile file("otn_trace_replay.csv");
+    file.write(
+        "0,add,1,ODU2,1000\n"
+        "1,add,2,ODU2,1000\n"
+        "2,remove,1\n"
+        "3,add,3,ODU1,10\n"
+    );
+
+    ReplayConfig config;
+    config.parent_level = OduLevel::ODU3;
+    TraceReader reader(file.path());
+    const ReplayStats s = replay_trace(reader, config);
+
+    EXPECT_EQ(s.records, 4u);
+    EXPECT_EQ(s.admitted, 3u);
+    EXPECT_EQ(s.adds_per_level[2], 2u);
+    EXPECT_DOUBLE_EQ(s.final_utilization, 5.0 / 16.0);
+}